@@ -0,0 +1,126 @@
+// Minimal benchmark harness for cpp-typename-parser
+//
+// Usage:
+//   BENCHMARK( my_benchmark ){
+//       for( size_t i = 0 ; i < iterations ; i++ )
+//           bench::do_not_optimize( ... );
+//   }
+//
+// Every benchmark is run once with zero iterations (to build its inputs) and then
+// with an increasing number of iterations until it ran for at least bench::min_duration. The main program (main.cpp) runs all registered
+// benchmarks whose name contains the (optional) filter passed as argument and
+// prints ns/op, ops/s, allocs/op and allocated bytes/op as text, or with '--json' or '--csv' in a
+// machine-readable form to diff results across versions. Benchmarks that set
+// bench::bytes_per_op() additionally report their throughput in bytes/cycle
+// (in reference cycles of the time stamp counter, x86 only).
+// It also replaces the global operator new in order to count heap allocations.
+
+#ifndef _CPP_TYPENAME_PARSER_BENCH_H_
+#define _CPP_TYPENAME_PARSER_BENCH_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // For __rdtsc
+#endif
+
+namespace bench
+{
+	using clock = std::chrono::steady_clock;
+
+	static constexpr std::chrono::milliseconds min_duration{ 200 };
+
+	struct benchmark
+	{
+		const char*	name;
+		void		(*function)( size_t iterations );
+	};
+	
+	struct measurement
+	{
+		double	ns_per_op;
+		double	allocations_per_op;
+		double	allocated_bytes_per_op;
+		double	bytes_per_cycle; // Zero, if unknown
+	};
+	
+	//! Number of heap allocations performed so far (maintained by main.cpp)
+	inline std::atomic<size_t>& allocations(){
+		static std::atomic<size_t> instance{ 0 };
+		return instance;
+	}
+
+	//! Number of bytes allocated on the heap so far (maintained by main.cpp)
+	inline std::atomic<size_t>& allocated_bytes(){
+		static std::atomic<size_t> instance{ 0 };
+		return instance;
+	}
+
+	//! Number of input bytes processed per iteration by the running benchmark (set by the benchmark itself, zero if not applicable)
+	inline size_t& bytes_per_op(){
+		static size_t instance = 0;
+		return instance;
+	}
+	
+	//! Returns the time stamp counter or zero, if there is none
+	inline unsigned long long cycles(){
+	#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+	#else
+		return 0;
+	#endif
+	}
+
+	inline std::vector<benchmark>& registry(){
+		static std::vector<benchmark> instance;
+		return instance;
+	}
+
+	struct registrar{
+		registrar( const char* name , void(*function)( size_t ) ){ registry().push_back( { name , function } ); }
+	};
+
+	//! Prevents the compiler from optimizing away the computation of 'value'
+	template<typename T>
+	inline void do_not_optimize( const T& value ){
+		asm volatile( "" : : "r,m"( value ) : "memory" );
+	}
+
+	//! Runs 'b' and returns the time and number of heap allocations per iteration
+	inline measurement run( const benchmark& b )
+	{
+		bytes_per_op() = 0;
+		b.function( 0 ); // Builds the (static) inputs of the benchmark outside of the measurement
+		for( size_t iterations = 1 ; ; iterations *= 2 ){
+			size_t num_allocations = allocations();
+			size_t num_bytes = allocated_bytes();
+			auto start = clock::now();
+			auto start_cycles = cycles();
+			b.function( iterations );
+			auto num_cycles = cycles() - start_cycles;
+			auto duration = clock::now() - start;
+			num_allocations = allocations() - num_allocations;
+			num_bytes = allocated_bytes() - num_bytes;
+			if( duration >= min_duration )
+				return {
+					std::chrono::duration<double, std::nano>( duration ).count() / iterations
+					, double( num_allocations ) / iterations
+					, double( num_bytes ) / iterations
+					, num_cycles ? double( bytes_per_op() ) * iterations / num_cycles : 0
+				};
+		}
+	}
+}
+
+#define BENCHMARK_CONCAT2( a , b ) a##b
+#define BENCHMARK_CONCAT( a , b ) BENCHMARK_CONCAT2( a , b )
+#define BENCHMARK( name ) \
+	static void name( size_t iterations ); \
+	static bench::registrar BENCHMARK_CONCAT( name , _registrar ){ #name , &name }; \
+	static void name( size_t iterations )
+
+#endif
@@ -0,0 +1,56 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+namespace
+{
+	const char* corpus[] = {
+		"void(*)(int,const std::string&)"
+		, "unsigned int const (::TestClass::*const)(int, const double)"
+		, "std::map<std::string, std::vector<int> > const&"
+		, "const volatile char* const (*(&)[4])[8]"
+		, "int(*(*)(long,char*))(float(&)[3],double(*)(void))"
+		, "long long unsigned int"
+	};
+}
+
+BENCHMARK( parse_batch_heap ){
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		std::vector<parser::type> batch;
+		batch.reserve( std::size( corpus ) );
+		for( const char* str : corpus )
+			batch.emplace_back( str );
+		bench::do_not_optimize( batch );
+	}
+}
+
+BENCHMARK( parse_batch_arena ){
+	parser::type_arena arena;
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		{
+			std::pmr::vector<parser::type> batch( &arena );
+			batch.reserve( std::size( corpus ) );
+			for( const char* str : corpus )
+				batch.emplace_back( str );
+			bench::do_not_optimize( batch );
+		}
+		arena.release();
+	}
+}
+
+BENCHMARK( from_type_heap ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( parser::type::from_type<void(*)(int,const char*&,long[4])>() );
+}
+
+BENCHMARK( from_type_arena ){
+	parser::type_arena arena;
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		bench::do_not_optimize( parser::type::from_type<void(*)(int,const char*&,long[4])>( &arena ) );
+		arena.release();
+	}
+}
+
+BENCHMARK( from_type_ref ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( &parser::type::from_type_ref<void(*)(int,const char*&,long[4])>() );
+}
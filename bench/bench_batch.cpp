@@ -0,0 +1,51 @@
+#include "bench.h"
+#include "cpp-typename-parser-batch.h"
+
+namespace
+{
+	constexpr size_t num_entries = 16384;
+	
+	//! A symbol dump like buffer of 'num_entries' newline-separated type names
+	const std::string& corpus(){
+		static const std::string instance = []{
+			const char* types[] = {
+				"const unsigned int"
+				, "std::map<std::string, std::vector<int> > const&"
+				, "void (*(*)(int, char))(double)"
+				, "int (::ns::Class::*)(const char*, unsigned long) const"
+				, "char const* volatile* const"
+				, "std::unique_ptr<std::basic_string<char, std::char_traits<char>, std::allocator<char> > >&&"
+				, "double (&)[3][4]"
+				, "ns::detail::node<T, 4>*"
+			};
+			std::string result;
+			for( size_t i = 0 ; i < num_entries ; i++ )
+				( result += types[i % ( sizeof(types) / sizeof(*types) )] ) += '\n';
+			return result;
+		}();
+		return instance;
+	}
+	
+	//! Parses the whole corpus with 'num_threads' threads (one op = 'num_entries' types)
+	template<unsigned num_threads>
+	void parse_batch_threads( size_t iterations ){
+		parser::batch_options options;
+		options.num_threads = num_threads;
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::parse_batch( corpus() , options ) );
+	}
+	
+	bench::registrar parse_batch_threads_1{ "parse_batch_threads_1" , &parse_batch_threads<1> };
+	bench::registrar parse_batch_threads_2{ "parse_batch_threads_2" , &parse_batch_threads<2> };
+	bench::registrar parse_batch_threads_4{ "parse_batch_threads_4" , &parse_batch_threads<4> };
+	bench::registrar parse_batch_threads_8{ "parse_batch_threads_8" , &parse_batch_threads<8> };
+	bench::registrar parse_batch_threads_16{ "parse_batch_threads_16" , &parse_batch_threads<16> };
+	bench::registrar parse_batch_threads_all{ "parse_batch_threads_all" , &parse_batch_threads<0> };
+}
+
+BENCHMARK( parse_sequential ){
+	std::vector<std::string_view> names = parser::detail::split_entries( corpus() );
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( std::string_view name : names )
+			bench::do_not_optimize( parser::type( name ) );
+}
@@ -0,0 +1,79 @@
+#include "bench.h"
+#include "cpp-typename-parser-cache.h"
+#include <thread>
+
+namespace
+{
+	constexpr unsigned num_reader_threads = 16;
+	
+	//! A few thousand distinct names, as seen by services resolving RTTI and configuration types
+	const std::vector<std::string>& names(){
+		static const std::vector<std::string> instance = []{
+			const char* patterns[] = {
+				"std::vector<ns::Type%u>"
+				, "const ns::detail::Node%u*"
+				, "void (*)(ns::Event%u const&, unsigned long)"
+				, "std::map<std::string, ns::Value%u> const&"
+			};
+			std::vector<std::string> result;
+			char buffer[128];
+			for( unsigned i = 0 ; i < 2048 ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , patterns[i % 4] , i );
+				result.push_back( buffer );
+			}
+			return result;
+		}();
+		return instance;
+	}
+	
+	//! Runs 'iterations' lookups in total, split evenly among 'num_threads' threads
+	template<typename Function>
+	void run_threads( size_t iterations , unsigned num_threads , Function function ){
+		std::vector<std::thread> threads;
+		for( unsigned t = 0 ; t < num_threads ; t++ )
+			threads.emplace_back( [&,t]{
+				const std::vector<std::string>& n = names();
+				for( size_t i = t ; i < iterations ; i += num_threads )
+					function( n[ ( i * 7919 ) % n.size() ] );
+			});
+		for( std::thread& thread : threads )
+			thread.join();
+	}
+	
+	parser::type_cache& cache(){
+		static parser::type_cache instance( 4096 );
+		return instance;
+	}
+}
+
+BENCHMARK( parse_every_time_16_threads ){
+	run_threads( iterations , num_reader_threads , []( const std::string& name ){
+		bench::do_not_optimize( parser::type( name ) );
+	});
+}
+
+BENCHMARK( cache_lookup_16_threads ){
+	run_threads( iterations , num_reader_threads , []( const std::string& name ){
+		bench::do_not_optimize( cache().get( name ) );
+	});
+}
+
+BENCHMARK( parse_every_time ){
+	run_threads( iterations , 1 , []( const std::string& name ){
+		bench::do_not_optimize( parser::type( name ) );
+	});
+}
+
+BENCHMARK( cache_lookup ){
+	run_threads( iterations , 1 , []( const std::string& name ){
+		bench::do_not_optimize( cache().get( name ) );
+	});
+}
+
+// Working set twice the capacity, so that most lookups miss and evict
+BENCHMARK( cache_lookup_thrashing ){
+	static parser::type_cache small_cache( 1024 );
+	run_threads( iterations , 1 , []( const std::string& name ){
+		bench::do_not_optimize( small_cache.get( name ) );
+	});
+}
@@ -0,0 +1,63 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+#include <unordered_set>
+
+namespace
+{
+	//! Names of 256 distinct types, each spelled in four different ways
+	const std::vector<std::string>& get_corpus(){
+		static const std::vector<std::string> instance = []{
+			const char* spellings[] = {
+				"const ns::Type%u<unsigned, long int>*"
+				, "ns::Type%u<int unsigned,long> const *"
+				, "::ns::Type%u< unsigned int , signed long >const*"
+				, "const ::ns::Type%u<unsigned int, long>*"
+			};
+			std::vector<std::string> result;
+			char buffer[128];
+			for( unsigned i = 0 ; i < 1024 ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , spellings[i % 4] , i / 4 );
+				result.emplace_back( buffer );
+			}
+			return result;
+		}();
+		return instance;
+	}
+}
+
+//! Dedupes the corpus by canonical types (finds 256 distinct types)
+BENCHMARK( dedupe_canonical ){
+	const std::vector<std::string>& corpus = get_corpus();
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		std::unordered_set<parser::type> distinct;
+		for( const std::string& name : corpus )
+			distinct.insert( parser::type::parse_canonical( name ) );
+		bench::do_not_optimize( distinct.size() );
+	}
+}
+
+//! Dedupes the corpus by parsed types, as before canonicalization (finds 1024 distinct types)
+BENCHMARK( dedupe_parsed ){
+	const std::vector<std::string>& corpus = get_corpus();
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		std::unordered_set<parser::type> distinct;
+		for( const std::string& name : corpus )
+			distinct.insert( parser::type( name ) );
+		bench::do_not_optimize( distinct.size() );
+	}
+}
+
+BENCHMARK( canonicalize ){
+	parser::type t( "ns::Type1<int unsigned,long> const *" );
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		parser::type copy = t;
+		bench::do_not_optimize( copy.canonicalize() );
+	}
+}
+
+BENCHMARK( compare_canonical ){
+	parser::type lhs = parser::type::parse_canonical( "ns::Type1<int unsigned,long> const *" );
+	parser::type rhs = parser::type::parse_canonical( "const ::ns::Type1<unsigned int, long>*" );
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( lhs == rhs );
+}
@@ -0,0 +1,161 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+#include <functional>
+#include <map>
+#include <memory>
+
+// Every public operation (parse, to_string, comparison, from_type) measured on realistic corpora.
+// A single iteration processes the whole corpus.
+
+namespace
+{
+	//! Names as printed by demangling STL-heavy symbols (gcc, libstdc++)
+	std::vector<std::string> stl_corpus(){
+		return {
+			"std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> >"
+			, "std::vector<int, std::allocator<int> > const&"
+			, "std::map<std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::vector<double, std::allocator<double> >, std::less<std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > >, std::allocator<std::pair<std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > const, std::vector<double, std::allocator<double> > > > >*"
+			, "std::unique_ptr<ns::Widget, std::default_delete<ns::Widget> >&&"
+			, "std::shared_ptr<std::vector<ns::Event, std::allocator<ns::Event> > > const&"
+			, "std::function<void (int, std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > const&)>"
+			, "std::_Rb_tree_iterator<std::pair<int const, ns::Value> >"
+			, "std::unordered_map<unsigned long, std::pair<float, float>, std::hash<unsigned long>, std::equal_to<unsigned long>, std::allocator<std::pair<unsigned long const, std::pair<float, float> > > >"
+			, "std::tuple<int, long, std::optional<double>, std::variant<int, float, std::monostate> > const volatile*"
+			, "std::array<std::array<unsigned char, 16ul>, 4ul>&"
+		};
+	}
+
+	//! Deeply nested function pointers and arrays
+	std::vector<std::string> declarator_corpus(){
+		return {
+			"int (*(*(*(*)(int))(long))(char))(double)"
+			, "int (*(*(*)[4])(char const*, unsigned))[8]"
+			, "char (&(*(*)[3][4])(void (*)(int (*)(char (&)[2]))))[16]"
+			, "double (*const (*volatile (*)(float, short))[2])(long double)"
+			, "int (*(*(*(*(*(*(*(*)(int))(int))(int))(int))(int))(int))(int))(int)"
+			, "unsigned long[1][2][3][4][5][6][7][8]"
+			, "void (*(&)[10])(int (*)(int (*)(int (*)(int))))"
+			, "const char* volatile* const* (*)(int&&, const int&, int*)"
+		};
+	}
+
+	//! Pointers to data members and member functions
+	std::vector<std::string> member_pointer_corpus(){
+		return {
+			"int (ns::Class::*)(int) const"
+			, "double ns::Outer<int>::Inner::*"
+			, "void (::A::* const)(char const*, int (B::*)(long))"
+			, "std::string (Widget::*(*)(int))(std::string const&) volatile"
+			, "const volatile unsigned int (::TestClass::* const)(int, const double&)"
+			, "int ns::S::* (ns::T::*)(int ns::U::*)"
+			, "void (std::vector<int>::*)(std::vector<int>::size_type)"
+			, "char (C::*(D::*)[4])(char)"
+		};
+	}
+
+	//! Long and deep chains of template-ids
+	std::vector<std::string> template_corpus(){
+		std::vector<std::string> result;
+		std::string nested = "int";
+		for( int i = 0 ; i < 16 ; i++ )
+			nested = "ns::Level" + std::to_string( i ) + "<" + nested + ", std::size_t>";
+		result.push_back( nested );
+		std::string wide = "std::tuple<";
+		for( int i = 0 ; i < 32 ; i++ )
+			wide += ( i ? ", ns::Element" : "ns::Element" ) + std::to_string( i );
+		result.push_back( wide + ">" );
+		std::string qualified;
+		for( int i = 0 ; i < 8 ; i++ )
+			qualified += ( i ? "::Scope" : "Scope" ) + std::to_string( i ) + "<" + std::to_string( i ) + ", bool>";
+		result.push_back( "const " + qualified + "&" );
+		return result;
+	}
+
+	struct corpus
+	{
+		std::vector<std::string>	names;
+		std::vector<parser::type>	types;
+		std::vector<parser::type>	copies; // Structurally equal to 'types', but parsed separately
+
+		explicit corpus( std::vector<std::string> input ) : names( std::move(input) ) {
+			for( const std::string& name : names ){
+				types.emplace_back( name );
+				copies.emplace_back( name );
+			}
+		}
+	};
+
+	template<std::vector<std::string>(*Generator)()>
+	const corpus& get_corpus(){
+		static const corpus instance( Generator() );
+		return instance;
+	}
+
+	template<std::vector<std::string>(*Generator)()>
+	void parse( size_t iterations ){
+		const corpus& c = get_corpus<Generator>();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const std::string& name : c.names )
+				bench::do_not_optimize( parser::type( name ) );
+	}
+
+	template<std::vector<std::string>(*Generator)()>
+	void to_string( size_t iterations ){
+		const corpus& c = get_corpus<Generator>();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const parser::type& t : c.types )
+				bench::do_not_optimize( t.to_string() );
+	}
+
+	template<std::vector<std::string>(*Generator)()>
+	void compare( size_t iterations ){
+		const corpus& c = get_corpus<Generator>();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( size_t j = 0 ; j < c.types.size() ; j++ )
+				bench::do_not_optimize( c.types[j] == c.copies[j] );
+	}
+
+	template<typename... T>
+	void from_type( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			( bench::do_not_optimize( parser::type::from_type<T>() ) , ... );
+	}
+
+	struct Widget{};
+
+	bench::registrar registrars[] = {
+		{ "corpus_parse_stl" , &parse<stl_corpus> }
+		, { "corpus_parse_declarators" , &parse<declarator_corpus> }
+		, { "corpus_parse_member_pointers" , &parse<member_pointer_corpus> }
+		, { "corpus_parse_templates" , &parse<template_corpus> }
+		, { "corpus_to_string_stl" , &to_string<stl_corpus> }
+		, { "corpus_to_string_declarators" , &to_string<declarator_corpus> }
+		, { "corpus_to_string_member_pointers" , &to_string<member_pointer_corpus> }
+		, { "corpus_to_string_templates" , &to_string<template_corpus> }
+		, { "corpus_compare_stl" , &compare<stl_corpus> }
+		, { "corpus_compare_declarators" , &compare<declarator_corpus> }
+		, { "corpus_compare_member_pointers" , &compare<member_pointer_corpus> }
+		, { "corpus_compare_templates" , &compare<template_corpus> }
+		, {
+			"corpus_from_type_stl"
+			, &from_type<
+				std::string , const std::vector<int>& , std::map<std::string, std::vector<double>>*
+				, std::unique_ptr<Widget>&& , std::function<void(int, const std::string&)>
+			>
+		}
+		, {
+			"corpus_from_type_declarators"
+			, &from_type<
+				int(*(*(*)(int))(long))(char) , int(*(*(*)[4])(const char*, unsigned))[8]
+				, double(*const(*volatile(*)(float, short))[2])(long double) , unsigned long[1][2][3][4]
+			>
+		}
+		, {
+			"corpus_from_type_member_pointers"
+			, &from_type<
+				int (Widget::*)(int) , double Widget::* , void (Widget::* const)(const char*, int (Widget::*)(long))
+				, char (Widget::*(Widget::*)[4])(char)
+			>
+		}
+	};
+}
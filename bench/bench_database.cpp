@@ -0,0 +1,70 @@
+#include "bench.h"
+#include "cpp-typename-parser-database.h"
+
+namespace
+{
+	constexpr size_t num_entries = 65536;
+	
+	const std::vector<std::string>& names(){
+		static const std::vector<std::string> instance = []{
+			const char* patterns[] = {
+				"const ns::Type%zu*"
+				, "std::map<std::string, std::vector<ns::Value%zu>> const&"
+				, "void (*)(ns::Event%zu const&, unsigned long)"
+				, "int (ns::Class%zu::*)(const char*) const"
+			};
+			std::vector<std::string> result;
+			char buffer[128];
+			for( size_t i = 0 ; i < num_entries ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , patterns[i % 4] , i / 4 );
+				result.emplace_back( buffer );
+			}
+			return result;
+		}();
+		return instance;
+	}
+	
+	const std::string& database_image(){
+		static const std::string instance = []{
+			parser::type_database_writer writer;
+			for( const std::string& name : names() )
+				writer.add( parser::type( name ) );
+			return writer.serialize();
+		}();
+		return instance;
+	}
+}
+
+//! Startup from text: Parse all entries (one op = 'num_entries' types)
+BENCHMARK( startup_parse_text ){
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		std::vector<parser::type> types;
+		types.reserve( num_entries );
+		for( const std::string& name : names() )
+			types.emplace_back( name );
+		bench::do_not_optimize( types );
+	}
+}
+
+//! Startup from a database image: Open it (one op = 'num_entries' types)
+BENCHMARK( startup_open_database ){
+	const std::string& image = database_image();
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( parser::type_database( image ).size() );
+}
+
+BENCHMARK( database_is_pointer ){
+	parser::type_database database( database_image() );
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( database[i % num_entries].is_pointer() );
+}
+
+BENCHMARK( database_to_string ){
+	parser::type_database database( database_image() );
+	std::string output;
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		output.clear();
+		database[i % num_entries].to_string( output , {} );
+		bench::do_not_optimize( output );
+	}
+}
@@ -0,0 +1,49 @@
+#include "bench.h"
+#include "cpp-typename-parser-find.h"
+
+// Throughput of find_types() on multi-megabyte free-form text (bytes/cycle).
+
+namespace
+{
+	//! About 4 MiB of compiler diagnostics and 'nm -C' output
+	const std::string& log_text(){
+		static const std::string instance = []{
+			const char* lines[] = {
+				"src/widget.cpp:42:17: error: cannot convert 'std::vector<int, std::allocator<int> >*' to 'const char (&)[16]'\n"
+				, "0000000000401136 T ns::Widget::resize(unsigned long, std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> > const&)\n"
+				, "[ 37%] Building CXX object CMakeFiles/app.dir/src/main.cpp.o (took 1234 ms, 0x7ffd5e8 bytes)\n"
+				, "note: candidate function not viable: no known conversion from 'int' to 'void (*)(double)' for 1st argument\n"
+				, "Linking the executable, this may take a while until all objects have been processed by the linker\n"
+			};
+			std::string result;
+			for( size_t i = 0 ; result.size() < ( 4 << 20 ) ; i++ )
+				result += lines[i % ( sizeof(lines) / sizeof(*lines) )];
+			return result;
+		}();
+		return instance;
+	}
+	
+	//! The same text without any type names (measures the candidate scan only)
+	const std::string& prose_text(){
+		static const std::string instance = []{
+			std::string result;
+			while( result.size() < ( 4 << 20 ) )
+				result += "Linking the executable, this may take a while until all 1234 objects have been processed by the linker.\n";
+			return result;
+		}();
+		return instance;
+	}
+	
+	template<const std::string&(*Text)()>
+	void find_types( size_t iterations ){
+		const std::string& input = Text();
+		bench::bytes_per_op() = input.size();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::find_types( input , []( parser::found_type&& found ){ bench::do_not_optimize( found ); } ) );
+	}
+	
+	bench::registrar registrars[] = {
+		{ "find_types_log" , &find_types<&log_text> }
+		, { "find_types_prose" , &find_types<&prose_text> }
+	};
+}
@@ -0,0 +1,48 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+// Heap memory held by a million parsed types (see B/op, one op parses the whole corpus).
+// The vector holding the types is reserved up front, so B/op = 1M * sizeof(type) + the heap memory of the types.
+
+namespace
+{
+	constexpr size_t corpus_size = 1000000;
+	
+	//! Mostly short types (1-4 layers), as found in symbol tables and debug information
+	const std::vector<std::string>& corpus(){
+		static const std::vector<std::string> instance = []{
+			const char* patterns[] = {
+				"ns::Type%u"
+				, "const ns::Type%u*"
+				, "std::vector<ns::Value%u> const&"
+				, "unsigned long"
+				, "char const* const*"
+				, "ns::Type%u&&"
+				, "int[%u]"
+				, "void (*)(ns::Event%u const&, unsigned long)"
+				, "int (ns::Class%u::*)(const char*) const"
+				, "ns::Matrix<float, 4, 4> (&)[%u][4]"
+			};
+			std::vector<std::string> result;
+			result.reserve( corpus_size );
+			char buffer[128];
+			for( unsigned i = 0 ; i < corpus_size ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , patterns[i % std::size( patterns )] , i % 1000 );
+				result.emplace_back( buffer );
+			}
+			return result;
+		}();
+		return instance;
+	}
+}
+
+BENCHMARK( footprint_parse_1m_types ){
+	const std::vector<std::string>& names = corpus();
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		std::vector<parser::type> types;
+		types.reserve( names.size() );
+		for( const std::string& name : names )
+			types.emplace_back( name );
+		bench::do_not_optimize( types );
+	}
+}
@@ -0,0 +1,61 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+#include <unordered_map>
+
+namespace
+{
+	//! Distinct types used as keys and the types looked up (separate objects, structurally equal to the keys)
+	struct corpus
+	{
+		std::vector<parser::type>	keys;
+		std::vector<parser::type>	queries;
+		
+		corpus(){
+			const char* patterns[] = {
+				"const ns::Type%u*"
+				, "std::vector<ns::Value%u> const&"
+				, "void (*)(ns::Event%u const&, unsigned long)"
+				, "int (ns::Class%u::*)(const char*) const"
+			};
+			char buffer[128];
+			for( unsigned i = 0 ; i < 1024 ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , patterns[i % 4] , i );
+				keys.emplace_back( buffer );
+				queries.emplace_back( buffer );
+			}
+		}
+	};
+	
+	const corpus& get_corpus(){
+		static const corpus instance;
+		return instance;
+	}
+}
+
+BENCHMARK( map_lookup_by_type ){
+	const corpus& c = get_corpus();
+	std::unordered_map<parser::type, size_t> map;
+	for( size_t i = 0 ; i < c.keys.size() ; i++ )
+		map.emplace( c.keys[i] , i );
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( map.find( c.queries[i % c.queries.size()] ) );
+}
+
+// The workaround of keying maps by the string representation
+BENCHMARK( map_lookup_by_string ){
+	const corpus& c = get_corpus();
+	std::unordered_map<std::string, size_t> map;
+	for( size_t i = 0 ; i < c.keys.size() ; i++ )
+		map.emplace( c.keys[i].to_string() , i );
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( map.find( c.queries[i % c.queries.size()].to_string() ) );
+}
+
+BENCHMARK( hash_uncached ){
+	const corpus& c = get_corpus();
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		parser::type t = c.queries[i % c.queries.size()];
+		t.remove_const(); // Invalidates the cached hash
+		bench::do_not_optimize( t.hash() );
+	}
+}
@@ -0,0 +1,50 @@
+#include "bench.h"
+#include "cpp-typename-parser-lazy.h"
+
+// Parsing a name only to ask one question about it, eagerly and lazily.
+// One op parses every name and queries it once.
+
+namespace
+{
+	const char* names[] = {
+		"std::map<std::string, std::vector<int> >&"
+		, "const std::basic_string<char, std::char_traits<char>, std::allocator<char> >*"
+		, "void (*)(int, char const*, ns::Widget&)"
+		, "ns::Matrix<float, 4, 4> const"
+		, "unsigned long"
+		, "std::unique_ptr<ns::Node, std::default_delete<ns::Node> >&&"
+		, "int (ns::Widget::*)(int, long) const"
+		, "const char* volatile"
+	};
+	
+	void pointer_eager( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const char* name : names )
+				bench::do_not_optimize( parser::type( name ).is_pointer() );
+	}
+	
+	void pointer_lazy( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const char* name : names )
+				bench::do_not_optimize( parser::lazy_type( name ).is_pointer() );
+	}
+	
+	void datatype_eager( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const char* name : names )
+				bench::do_not_optimize( parser::type( name ).get_datatype() );
+	}
+	
+	void datatype_lazy( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const char* name : names )
+				bench::do_not_optimize( parser::lazy_type( name ).get_datatype() );
+	}
+	
+	bench::registrar registrars[] = {
+		{ "query_is_pointer_eager" , &pointer_eager }
+		, { "query_is_pointer_lazy" , &pointer_lazy }
+		, { "query_datatype_eager" , &datatype_eager }
+		, { "query_datatype_lazy" , &datatype_lazy }
+	};
+}
@@ -0,0 +1,106 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+// Throughput of the scanners in detail::scan on long template names (bytes/cycle),
+// compared per instruction set and against the constexpr scanner used at compile time.
+
+namespace
+{
+	//! A demangled name of several kilobytes in the style of expression templates and range adaptors
+	const std::string& long_name(){
+		static const std::string instance = []{
+			std::string result = "double";
+			for( int i = 0 ; i < 12 ; i++ )
+				result = "boost::proto::exprns_::basic_expr<boost::proto::tagns_::tag::plus, boost::proto::argsns_::list2<"
+					+ result + ", std::ranges::transform_view<std::ranges::ref_view<std::vector<int, std::allocator<int> > >, ns::Functor" + std::to_string( i ) + ">>, 2l>";
+			return result;
+		}();
+		return instance;
+	}
+
+	//! A single identifier of several kilobytes (as in generated code)
+	const std::string& long_identifier(){
+		static const std::string instance = []{
+			std::string result;
+			while( result.size() < 4096 )
+				result += "generated_Identifier_" + std::to_string( result.size() );
+			return result;
+		}();
+		return instance;
+	}
+
+	//! Counts the brackets in the long name using 'find'
+	template<const char*(*Find)( const char* , const char* )>
+	void find_bracket( size_t iterations ){
+		const std::string& input = long_name();
+		bench::bytes_per_op() = input.size();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			size_t count = 0;
+			for( const char* pos = input.data() , *end = pos + input.size() ; ( pos = Find( pos , end ) ) != end ; pos++ )
+				count++;
+			bench::do_not_optimize( count );
+		}
+	}
+
+	template<const char*(*Skip)( const char* , const char* )>
+	void skip_identifier( size_t iterations ){
+		const std::string& input = long_identifier();
+		bench::bytes_per_op() = input.size();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( Skip( input.data() , input.data() + input.size() ) );
+	}
+
+	void match_angle_bracket_constexpr( size_t iterations ){
+		const std::string& input = long_name();
+		const char* open = input.data() + input.find( '<' );
+		bench::bytes_per_op() = input.size();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::detail::match_angle_bracket( open , input.data() + input.size() ) );
+	}
+
+	void match_angle_bracket_dispatched( size_t iterations ){
+		const std::string& input = long_name();
+		const char* open = input.data() + input.find( '<' );
+		bench::bytes_per_op() = input.size();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::detail::find_matching_angle_bracket( open , input.data() + input.size() ) );
+	}
+
+	void parse_long_name( size_t iterations ){
+		const std::string& input = long_name();
+		bench::bytes_per_op() = input.size();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::type( input ) );
+	}
+
+	void template_arguments_long_name( size_t iterations ){
+		const std::string& input = long_name();
+		bench::bytes_per_op() = input.size();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::detail::parse_template_arguments( input ) );
+	}
+
+	bench::registrar registrars[] = {
+		{ "lexer_find_bracket_scalar" , &find_bracket<&parser::detail::scan::find_bracket_scalar> }
+	#if CPP_TYPENAME_PARSER_SSE2
+		, { "lexer_find_bracket_sse2" , &find_bracket<&parser::detail::scan::find_bracket_sse2> }
+	#endif
+		, { "lexer_skip_identifier_scalar" , &skip_identifier<&parser::detail::scan::skip_identifier_scalar> }
+	#if CPP_TYPENAME_PARSER_SSE2
+		, { "lexer_skip_identifier_sse2" , &skip_identifier<&parser::detail::scan::skip_identifier_sse2> }
+	#endif
+		, { "lexer_match_angle_bracket_constexpr" , &match_angle_bracket_constexpr }
+		, { "lexer_match_angle_bracket_dispatched" , &match_angle_bracket_dispatched }
+		, { "lexer_parse_long_name" , &parse_long_name }
+		, { "lexer_template_arguments_long_name" , &template_arguments_long_name }
+	};
+	
+	#if CPP_TYPENAME_PARSER_AVX2
+	// Only registered if the CPU supports them
+	const bool avx2_registered = __builtin_cpu_supports( "avx2" ) && (
+		bench::registrar( "lexer_find_bracket_avx2" , &find_bracket<&parser::detail::scan::find_bracket_avx2> )
+		, bench::registrar( "lexer_skip_identifier_avx2" , &skip_identifier<&parser::detail::scan::skip_identifier_avx2> )
+		, true
+	);
+	#endif
+}
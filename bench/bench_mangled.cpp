@@ -0,0 +1,29 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+namespace
+{
+	// Type encodings, as found in symbol tables and returned by typeid(T).name()
+	const char* corpus[] = {
+		"PKc"
+		, "M5ClassKFivE"
+		, "RKNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEE"
+		, "St3mapIiSt6vectorIiSaIiEESt4lessIiESaISt4pairIKiS2_EEE"
+		, "PFvRKSsS0_E"
+		, "PA4_N2ns6detail4nodeIiLi4EEE"
+	};
+}
+
+BENCHMARK( from_mangled ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const char* mangled : corpus )
+			bench::do_not_optimize( parser::type::from_mangled( mangled ) );
+}
+
+#if defined(__GNUG__) && !defined(__clang__)
+BENCHMARK( demangle_then_parse ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const char* mangled : corpus )
+			bench::do_not_optimize( parser::type( parser::detail::demangle( mangled ) ) );
+}
+#endif
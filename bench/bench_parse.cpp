@@ -0,0 +1,43 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+namespace
+{
+	//! Builds "int(*(*(*...)(int))(int))(int)" with 'depth' nested declarators
+	std::string nested_declarators( int depth ){
+		std::string result = "*";
+		for( int i = 0 ; i < depth ; i++ )
+			result = "*(" + result + ")(int)";
+		return "int(" + result + ")(int)";
+	}
+
+	//! Builds "int[1][2]...[n]"
+	std::string array_chain( int length ){
+		std::string result = "int";
+		for( int i = 1 ; i <= length ; i++ )
+			result += "[" + std::to_string( i ) + "]";
+		return result;
+	}
+
+	template<int Depth>
+	void parse_nested( size_t iterations ){
+		static const std::string input = nested_declarators( Depth );
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::type( input ) );
+	}
+
+	template<int Length>
+	void parse_arrays( size_t iterations ){
+		static const std::string input = array_chain( Length );
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::type( input ) );
+	}
+
+	bench::registrar registrars[] = {
+		{ "parse_nested_declarators_4" , &parse_nested<4> }
+		, { "parse_nested_declarators_16" , &parse_nested<16> }
+		, { "parse_nested_declarators_64" , &parse_nested<64> }
+		, { "parse_array_chain_16" , &parse_arrays<16> }
+		, { "parse_array_chain_256" , &parse_arrays<256> }
+	};
+}
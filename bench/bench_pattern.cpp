@@ -0,0 +1,92 @@
+#include "bench.h"
+#include "cpp-typename-parser-pattern.h"
+
+// Classifying a million types against 134 patterns, as one pattern_set and one pattern at a time.
+// One op matches every type of the corpus.
+
+namespace
+{
+	constexpr size_t num_types = 1000000;
+	
+	const std::vector<std::string>& patterns(){
+		static const std::vector<std::string> instance = []{
+			std::vector<std::string> result = {
+				"std::vector<$T> const&" , "$R (*)($A...)" , "$T $C::*" , "$T const*" , "std::unique_ptr<$T>" , "std::map<$K, $V> const&"
+			};
+			for( int i = 0 ; i < 32 ; i++ ){
+				std::string name = "ns::Type" + std::to_string( i );
+				result.push_back( name + " const&" );
+				result.push_back( name + "*" );
+				result.push_back( "std::vector<" + name + ">" );
+				result.push_back( "std::map<" + name + ", $V>&" );
+			}
+			return result;
+		}();
+		return instance;
+	}
+	
+	const std::vector<parser::type>& corpus(){
+		static const std::vector<parser::type> instance = []{
+			const char* names[] = {
+				"ns::Type%u const&"
+				, "const ns::Type%u*"
+				, "std::vector<ns::Value%u> const&"
+				, "std::map<ns::Type%u, int>&"
+				, "unsigned long"
+				, "void (*)(ns::Event%u const&, unsigned long)"
+				, "int (ns::Class%u::*)(const char*) const"
+				, "std::unique_ptr<ns::Node%u>"
+				, "ns::Type%u*"
+				, "std::vector<ns::Type%u>"
+			};
+			std::vector<parser::type> result;
+			result.reserve( num_types );
+			char buffer[128];
+			for( unsigned i = 0 ; i < num_types ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , names[i % std::size( names )] , i % 64 );
+				result.emplace_back( buffer );
+			}
+			return result;
+		}();
+		return instance;
+	}
+	
+	void match_set( size_t iterations ){
+		static const parser::pattern_set set = []{
+			parser::pattern_set result;
+			for( const std::string& pattern : patterns() )
+				result.add( pattern );
+			return result;
+		}();
+		const std::vector<parser::type>& types = corpus();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			size_t matches = 0;
+			for( const parser::type& t : types )
+				matches += set.match( t , []( size_t , const std::vector<parser::pattern_capture>& ){} );
+			bench::do_not_optimize( matches );
+		}
+	}
+	
+	//! One pattern_set per pattern, which is what checking the patterns one after the other amounts to
+	void match_one_by_one( size_t iterations ){
+		static const std::vector<parser::pattern_set> sets = []{
+			std::vector<parser::pattern_set> result;
+			for( const std::string& pattern : patterns() )
+				result.push_back( { pattern } );
+			return result;
+		}();
+		const std::vector<parser::type>& types = corpus();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			size_t matches = 0;
+			for( const parser::type& t : types )
+				for( const parser::pattern_set& set : sets )
+					matches += set.match( t , []( size_t , const std::vector<parser::pattern_capture>& ){} );
+			bench::do_not_optimize( matches );
+		}
+	}
+	
+	bench::registrar registrars[] = {
+		{ "match_1m_types_134_patterns_set" , &match_set }
+		, { "match_1m_types_134_patterns_one_by_one" , &match_one_by_one }
+	};
+}
@@ -0,0 +1,87 @@
+#include "bench.h"
+#include "cpp-typename-parser-persistent.h"
+
+// Deriving pointer/reference/const variants of a few base types, as code generators do.
+// One op derives 8 variants of every base type.
+
+namespace
+{
+	const char* base_names[] = {
+		"std::map<std::string, std::vector<int> >"
+		, "void (*)(int, char const*, ns::Widget&)"
+		, "ns::Matrix<float, 4, 4>"
+		, "unsigned long"
+	};
+	
+	const std::vector<parser::type>& base_types(){
+		static const std::vector<parser::type> instance( std::begin( base_names ) , std::end( base_names ) );
+		return instance;
+	}
+	
+	const std::vector<parser::persistent_type>& base_persistent_types(){
+		static const std::vector<parser::persistent_type> instance = []{
+			std::vector<parser::persistent_type> result;
+			for( const parser::type& t : base_types() )
+				result.emplace_back( t );
+			return result;
+		}();
+		return instance;
+	}
+	
+	//! Applies 'modify' to a copy of 'base'
+	template<typename Modify>
+	parser::type derive( const parser::type& base , Modify&& modify ){
+		parser::type result = base;
+		modify( result );
+		return result;
+	}
+	
+	void derive_type( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const parser::type& base : base_types() ){
+				bench::do_not_optimize( derive( base , []( parser::type& t ){ t.add_const(); } ) );
+				bench::do_not_optimize( derive( base , []( parser::type& t ){ t.add_array( 4 ); } ) );
+				bench::do_not_optimize( derive( base , []( parser::type& t ){ t.add_function(); } ) );
+				bench::do_not_optimize( derive( base , []( parser::type& t ){ t.add_const(); t.add_array(); } ) );
+				bench::do_not_optimize( derive( base , []( parser::type& t ){ t.add_volatile(); } ) );
+				bench::do_not_optimize( derive( base , [&base]( parser::type& t ){ t.add_function( { std::make_shared<parser::type>( base ) } ); } ) );
+				bench::do_not_optimize( parser::type( base ) );
+				bench::do_not_optimize( derive( base , []( parser::type& t ){ t.set_datatype( parser::type( "int" ) ); } ) );
+			}
+	}
+	
+	void derive_persistent( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const parser::persistent_type& base : base_persistent_types() ){
+				bench::do_not_optimize( base.add_const() );
+				bench::do_not_optimize( base.add_array( 4 ) );
+				bench::do_not_optimize( base.add_function() );
+				bench::do_not_optimize( base.add_const().add_array() );
+				bench::do_not_optimize( base.add_volatile() );
+				bench::do_not_optimize( base.add_function( { base } ) );
+				bench::do_not_optimize( parser::persistent_type( base ) );
+				bench::do_not_optimize( base.set_datatype( parser::persistent_type( "int" ) ) );
+			}
+	}
+	
+	//! Pointer/reference/const variants, that 'type' has no modifiers for (two levels deep)
+	void derive_persistent_indirections( size_t iterations ){
+		for( size_t i = 0 ; i < iterations ; i++ )
+			for( const parser::persistent_type& base : base_persistent_types() ){
+				parser::persistent_type ptr = base.add_pointer();
+				bench::do_not_optimize( ptr.add_const() );
+				bench::do_not_optimize( ptr.add_lvalue_reference() );
+				bench::do_not_optimize( base.add_const().add_lvalue_reference() );
+				bench::do_not_optimize( base.add_rvalue_reference() );
+				bench::do_not_optimize( ptr.add_pointer() );
+				bench::do_not_optimize( ptr.add_const().add_pointer() );
+				bench::do_not_optimize( base.add_const().add_pointer().add_lvalue_reference() );
+			}
+	}
+	
+	bench::registrar registrars[] = {
+		{ "derive_variants_type" , &derive_type }
+		, { "derive_variants_persistent" , &derive_persistent }
+		, { "derive_indirections_persistent" , &derive_persistent_indirections }
+	};
+}
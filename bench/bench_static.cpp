@@ -0,0 +1,19 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+namespace
+{
+	constexpr auto plugin_signature = parser::parse_static( "int (*)(const char*, std::vector<std::string> const&, void (*)(int, double))" );
+	
+	static_assert( plugin_signature.is_pointer() && plugin_signature.get_datatype() == "int" , "Parsed at compile time" );
+}
+
+BENCHMARK( static_type_to_type ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( plugin_signature.to_type() );
+}
+
+BENCHMARK( runtime_parse_same_type ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( parser::type( "int (*)(const char*, std::vector<std::string> const&, void (*)(int, double))" ) );
+}
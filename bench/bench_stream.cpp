@@ -0,0 +1,53 @@
+#include "bench.h"
+#include "cpp-typename-parser-stream.h"
+
+namespace
+{
+	//! 4096 newline-separated type names
+	const std::string& corpus(){
+		static const std::string instance = []{
+			const char* types[] = {
+				"const unsigned int"
+				, "std::map<std::string, std::vector<int> > const&"
+				, "void (*(*)(int, char))(double)"
+				, "int (::ns::Class::*)(const char*, unsigned long) const"
+				, "std::unique_ptr<std::basic_string<char, std::char_traits<char>, std::allocator<char> > >&&"
+				, "double (&)[3][4]"
+			};
+			std::string result;
+			for( size_t i = 0 ; i < 4096 ; i++ )
+				( result += types[i % ( sizeof(types) / sizeof(*types) )] ) += '\n';
+			return result;
+		}();
+		return instance;
+	}
+	
+	//! Feeds the corpus in chunks of 'chunk_size' bytes (one op = the whole corpus)
+	template<size_t chunk_size>
+	void stream_parse_chunks( size_t iterations ){
+		std::string_view input = corpus();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			size_t num_types = 0;
+			parser::stream_parser stream( [&num_types]( parser::batch_entry&& entry ){ num_types += entry.success; } );
+			for( size_t offset = 0 ; offset < input.size() ; offset += chunk_size )
+				stream.feed( input.substr( offset , chunk_size ) );
+			stream.finish();
+			bench::do_not_optimize( num_types );
+		}
+	}
+	
+	//! Parses the whole corpus at once for comparison
+	void parse_batch_whole( size_t iterations ){
+		parser::batch_options options;
+		options.num_threads = 1;
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( parser::parse_batch( corpus() , options ) );
+	}
+	
+	bench::registrar registrars[] = {
+		{ "stream_parse_chunks_16" , &stream_parse_chunks<16> }
+		, { "stream_parse_chunks_4096" , &stream_parse_chunks<4096> }
+		, { "stream_parse_chunks_65536" , &stream_parse_chunks<65536> }
+		, { "stream_parse_whole_batch" , &parse_batch_whole }
+	};
+}
@@ -0,0 +1,37 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+namespace
+{
+	const char* stl_string = "std::basic_string<char, std::char_traits<char>, std::allocator<char> >";
+	const char* stl_signature =
+		"std::basic_string<char, std::char_traits<char>, std::allocator<char> > const& (*)"
+		"(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&"
+		", std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> > >&)";
+}
+
+BENCHMARK( parse_repeated_stl_name ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( parser::type( stl_string ) );
+}
+
+BENCHMARK( compare_stl_signature ){
+	parser::type lhs( stl_signature );
+	parser::type rhs( stl_signature );
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		bench::do_not_optimize( lhs );
+		bench::do_not_optimize( lhs == rhs );
+	}
+}
+
+BENCHMARK( intern_existing_symbol ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( parser::symbol( stl_string ) );
+}
+
+BENCHMARK( primitive_keyword_lookup ){
+	const char* words[] = { "unsigned" , "long" , "Foo" , "char32_t" , "size_t" , "int" };
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const char* word : words )
+			bench::do_not_optimize( parser::symbol_table::find_primitive( word ) );
+}
@@ -0,0 +1,67 @@
+#include "bench.h"
+#include "cpp-typename-parser-table.h"
+
+// Scanning a million types for "const pointer to ns::Type7", as a std::vector<type> and as a type_table.
+// One op runs the query over all types.
+
+namespace
+{
+	constexpr size_t num_types = 1000000;
+	
+	const std::vector<parser::type>& types(){
+		static const std::vector<parser::type> instance = []{
+			const char* patterns[] = {
+				"ns::Type%u"
+				, "const ns::Type%u* const"
+				, "std::vector<ns::Value%u> const&"
+				, "ns::Type%u* const"
+				, "char const* const*"
+				, "ns::Type%u&&"
+				, "void (*)(ns::Event%u const&, unsigned long)"
+				, "ns::Type%u*"
+			};
+			std::vector<parser::type> result;
+			result.reserve( num_types );
+			char buffer[128];
+			for( unsigned i = 0 ; i < num_types ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , patterns[i % std::size( patterns )] , i % 16 );
+				result.emplace_back( buffer );
+			}
+			return result;
+		}();
+		return instance;
+	}
+	
+	const parser::type_table& table(){
+		static const parser::type_table instance = []{
+			parser::type_table result;
+			for( const parser::type& t : types() )
+				result.push_back( t );
+			return result;
+		}();
+		return instance;
+	}
+	
+	const parser::symbol wanted( "ns::Type7" );
+	
+	void query_vector( size_t iterations ){
+		const std::vector<parser::type>& all = types();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			size_t matches = 0;
+			for( const parser::type& t : all )
+				matches += t.is_pointer() && t.is_const() && t.begin()->content == wanted;
+			bench::do_not_optimize( matches );
+		}
+	}
+	
+	void query_table( size_t iterations ){
+		const parser::type_table& all = table();
+		for( size_t i = 0 ; i < iterations ; i++ )
+			bench::do_not_optimize( ( all.is_pointer() & all.is_const() & all.has_datatype( wanted ) ).count() );
+	}
+	
+	bench::registrar registrars[] = {
+		{ "scan_1m_const_pointers_vector" , &query_vector }
+		, { "scan_1m_const_pointers_table" , &query_table }
+	};
+}
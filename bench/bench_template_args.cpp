@@ -0,0 +1,26 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+namespace
+{
+	const char* template_type = "const std::unordered_map<std::string, std::vector<std::pair<int, ns::Value<(1>2)>>>>&";
+}
+
+BENCHMARK( parse_template_type ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( parser::type( template_type ) );
+}
+
+//! Cost of the first access to the template arguments of a name
+BENCHMARK( template_arguments_first_access ){
+	std::string_view name = parser::type( template_type ).get_datatype();
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( parser::detail::parse_template_arguments( name ) );
+}
+
+//! Cost of every later access
+BENCHMARK( template_arguments_cached ){
+	parser::type t( template_type );
+	for( size_t i = 0 ; i < iterations ; i++ )
+		bench::do_not_optimize( t.template_arguments().size() );
+}
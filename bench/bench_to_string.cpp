@@ -0,0 +1,151 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+#include <cassert>
+#include <cctype>
+
+namespace
+{
+	//! The previous implementation of type::to_string(), kept as a reference for comparison
+	namespace legacy
+	{
+		enum{ type_layer , pointer_layer , lvalue_layer , rvalue_layer , member_pointer_layer , function_layer , array_layer };
+
+		bool need_space( char lhs , char rhs ){
+			if( std::isalpha( lhs ) )
+				return std::isalpha( rhs ) || rhs == '*' || rhs == '(' || rhs == ':' ;
+			if( lhs == '*' || lhs == ')' || lhs == ':' )
+				return std::isalpha( rhs );
+			return false;
+		}
+
+		bool is_primitive_type( const std::string& str ){
+			static const char* primitive_types[13] = {
+				"char" , "char16_t" , "char32_t" , "wchar_t" , "bool" , "short"
+				, "int" , "long" , "signed" , "unsigned" , "float" , "double" , "void"
+			};
+			for( int i = 0 ; i < 13 ; i++ )
+				if( str == primitive_types[i] )
+					return true;
+			return false;
+		}
+
+		std::string to_string( const parser::type& t , std::string name = {} )
+		{
+			std::vector<std::string>	result;
+			int							last_layer_type = type_layer;
+			size_t						insert_pos = 0;
+
+			for( const auto& lr : t ){
+				switch( (int)lr.layer_type ){
+					case type_layer:
+						if( lr.is_const )
+							result.emplace( result.begin() + insert_pos++ , "const");
+						if( lr.is_volatile )
+							result.emplace( result.begin() + insert_pos++ , "volatile");
+						result.emplace( result.begin() + insert_pos++ , lr.content );
+						break;
+					case array_layer:
+						result.emplace( result.begin() + insert_pos , "]" );
+						result.emplace( result.begin() + insert_pos , lr.content );
+						result.emplace( result.begin() + insert_pos , "[" );
+						break;
+					case function_layer:{
+						result.emplace( result.begin() + insert_pos , ")" );
+						bool is_first = true;
+						for( auto it = lr.arguments.rbegin() ; it != lr.arguments.rend() ; it++ ){
+							if( !is_first )
+								result.emplace( result.begin() + insert_pos , "," );
+							else
+								is_first = false;
+							result.emplace( result.begin() + insert_pos , to_string( **it ) );
+						}
+						result.emplace( result.begin() + insert_pos , "(" );
+						break;
+					}
+					default:
+						static const char* lut[] = { "" , "*" , "&" , "&&" };
+						bool need_parens =
+							last_layer_type == array_layer
+							|| last_layer_type == function_layer
+							|| ( !is_primitive_type(result[insert_pos-1]) && lr.content.size() && lr.content.front() == ':' )
+						;
+						if( need_parens )
+							result.emplace( result.begin() + insert_pos++ , "(" );
+						if( (int)lr.layer_type == member_pointer_layer )
+							result.emplace( result.begin() + insert_pos++ , std::string(lr.content) + "::*" );
+						else
+							result.emplace( result.begin() + insert_pos++ , lut[(int)lr.layer_type] );
+						if( lr.is_const )
+							result.emplace( result.begin() + insert_pos++ , "const");
+						if( lr.is_volatile )
+							result.emplace( result.begin() + insert_pos++ , "volatile");
+						if( need_parens )
+							result.insert( result.begin() + insert_pos , ")" );
+						break;
+				}
+				last_layer_type = (int)lr.layer_type;
+			}
+
+			if( !name.empty() )
+				result.emplace( result.begin() + insert_pos , std::move(name) );
+
+			std::string output;
+
+			for( const auto& str : result ){
+				if( !output.empty() && !str.empty() && need_space( output.back() , str.front() ) )
+					output += ' ';
+				output += str;
+			}
+
+			return output;
+		}
+	}
+
+	//! Builds a function pointer type nested 'depth' levels deep, e.g. "int(*(*)(int,const double&))(int,const double&)"
+	std::string nested_function_pointer( int depth ){
+		std::string result = "int";
+		std::string declarator = "*";
+		for( int i = 0 ; i < depth ; i++ )
+			declarator = "*(" + declarator + ")(int,const double&)";
+		return result + "(" + declarator + ")(char)";
+	}
+
+	const std::vector<parser::type>& corpus(){
+		static std::vector<parser::type> result = []{
+			std::vector<parser::type> types;
+			for( int depth = 0 ; depth < 8 ; depth++ )
+				types.emplace_back( nested_function_pointer( depth ) );
+			types.emplace_back( "unsigned int const (::TestClass::*const)(int, const double)" );
+			types.emplace_back( "const volatile char* const (*(&)[4])[8]" );
+			for( [[maybe_unused]] const parser::type& t : types )
+				assert( legacy::to_string( t , "name" ) == t.to_string( "name" ) );
+			return types;
+		}();
+		return result;
+	}
+}
+
+BENCHMARK( to_string_legacy ){
+	const auto& types = corpus();
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const parser::type& t : types )
+			bench::do_not_optimize( legacy::to_string( t , "name" ) );
+}
+
+BENCHMARK( to_string_returned ){
+	const auto& types = corpus();
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const parser::type& t : types )
+			bench::do_not_optimize( t.to_string( "name" ) );
+}
+
+BENCHMARK( to_string_appended ){
+	const auto& types = corpus();
+	std::string buffer;
+	for( size_t i = 0 ; i < iterations ; i++ ){
+		buffer.clear();
+		for( const parser::type& t : types )
+			t.to_string( buffer , "name" );
+		bench::do_not_optimize( buffer );
+	}
+}
@@ -0,0 +1,39 @@
+#include "bench.h"
+#include "cpp-typename-parser.h"
+
+namespace
+{
+	const char* corpus[] = {
+		"const unsigned int"
+		, "std::map<std::string, std::vector<int> > const&"
+		, "void (*(*)(int, char))(double)"
+		, "int (::ns::Class::*)(const char*, unsigned long) const"
+		, "char const* volatile* const"
+		, "std::unique_ptr<std::basic_string<char, std::char_traits<char>, std::allocator<char> > >&&"
+	};
+}
+
+// Parse a type and query its outermost layer, as e.g. a reflection tool filtering symbols would
+BENCHMARK( query_via_type ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const char* str : corpus ){
+			parser::type t( str );
+			bench::do_not_optimize( t.is_pointer() || t.is_const() );
+			bench::do_not_optimize( t.get_datatype() );
+		}
+}
+
+BENCHMARK( query_via_type_view ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const char* str : corpus ){
+			parser::type_view t( str );
+			bench::do_not_optimize( t.is_pointer() || t.is_const() );
+			bench::do_not_optimize( t.get_datatype() );
+		}
+}
+
+BENCHMARK( type_view_to_owned ){
+	for( size_t i = 0 ; i < iterations ; i++ )
+		for( const char* str : corpus )
+			bench::do_not_optimize( parser::type_view( str ).to_owned() );
+}
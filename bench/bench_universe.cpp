@@ -0,0 +1,83 @@
+#include "bench.h"
+#include "cpp-typename-parser-universe.h"
+
+// A million function signatures built from few distinct parameter types, stored as 'type's and interned.
+// One op stores (resp. interns) all signatures. Since the universe keeps the types of the first op, later ops only look them up.
+
+namespace
+{
+	constexpr size_t num_signatures = 1000000;
+	
+	const std::vector<parser::type>& signatures(){
+		static const std::vector<parser::type> instance = []{
+			const char* patterns[] = {
+				"void (*)(int, ns::Event%u const&)"
+				, "int (ns::Class%u::*)(const char*, unsigned long) const"
+				, "bool (std::string const&, int, ns::Type%u*)"
+				, "std::vector<int> (*)(int, int, double)"
+			};
+			std::vector<parser::type> result;
+			result.reserve( num_signatures );
+			char buffer[128];
+			for( unsigned i = 0 ; i < num_signatures ; i++ ){
+				std::snprintf( buffer , sizeof(buffer) , patterns[i % std::size( patterns )] , i % 100 );
+				result.emplace_back( buffer );
+			}
+			return result;
+		}();
+		return instance;
+	}
+	
+	void copy_types( size_t iterations ){
+		const std::vector<parser::type>& all = signatures();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			std::vector<parser::type> result( all.begin() , all.end() );
+			bench::do_not_optimize( result );
+		}
+	}
+	
+	void intern_types( size_t iterations ){
+		static parser::type_universe universe;
+		const std::vector<parser::type>& all = signatures();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			std::vector<parser::interned_type> result;
+			result.reserve( all.size() );
+			for( const parser::type& t : all )
+				result.push_back( universe.intern( t ) );
+			bench::do_not_optimize( result );
+		}
+	}
+	
+	//! Compares every signature with the equal one 100 signatures before (distinct objects unless interned)
+	void compare_types( size_t iterations ){
+		const std::vector<parser::type>& all = signatures();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			size_t num_equal = 0;
+			for( size_t j = 100 ; j < all.size() ; j++ )
+				num_equal += all[j] == all[j - 100];
+			bench::do_not_optimize( num_equal );
+		}
+	}
+	
+	void compare_interned( size_t iterations ){
+		static const std::vector<parser::interned_type> all = []{
+			std::vector<parser::interned_type> result;
+			for( const parser::type& t : signatures() )
+				result.push_back( parser::intern( t ) );
+			return result;
+		}();
+		for( size_t i = 0 ; i < iterations ; i++ ){
+			size_t num_equal = 0;
+			for( size_t j = 100 ; j < all.size() ; j++ )
+				num_equal += all[j] == all[j - 100];
+			bench::do_not_optimize( num_equal );
+		}
+	}
+	
+	bench::registrar registrars[] = {
+		{ "store_1m_signatures_type" , &copy_types }
+		, { "store_1m_signatures_interned" , &intern_types }
+		, { "compare_1m_signatures_type" , &compare_types }
+		, { "compare_1m_signatures_interned" , &compare_interned }
+	};
+}
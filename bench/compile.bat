@@ -0,0 +1,16 @@
+@echo off
+
+cd %~dp0
+
+echo Compiling with G++...
+g++ -std=c++17 -I"../include" -O2 -Wall -pthread -o bench.exe *.cpp
+
+IF %ERRORLEVEL% NEQ 0 GOTO ERROR
+
+echo ...done & echo.
+
+:ERROR
+
+echo.
+
+pause
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "bench.h"
+#include <cstdlib>
+#include <new>
+
+void* operator new( size_t size ){
+	bench::allocations().fetch_add( 1 , std::memory_order_relaxed );
+	bench::allocated_bytes().fetch_add( size , std::memory_order_relaxed );
+	if( void* result = std::malloc( size ? size : 1 ) )
+		return result;
+	throw std::bad_alloc();
+}
+void* operator new( size_t size , std::align_val_t alignment ){
+	bench::allocations().fetch_add( 1 , std::memory_order_relaxed );
+	bench::allocated_bytes().fetch_add( size , std::memory_order_relaxed );
+	size_t align = static_cast<size_t>( alignment );
+	if( void* result = std::aligned_alloc( align , ( size + align - 1 ) / align * align ) )
+		return result;
+	throw std::bad_alloc();
+}
+void operator delete( void* ptr ) noexcept { std::free( ptr ); }
+void operator delete( void* ptr , size_t ) noexcept { std::free( ptr ); }
+void operator delete( void* ptr , std::align_val_t ) noexcept { std::free( ptr ); }
+void operator delete( void* ptr , size_t , std::align_val_t ) noexcept { std::free( ptr ); }
+
+namespace
+{
+	enum class output_format{ text , json , csv };
+
+	void print_header( output_format format ){
+		if( format == output_format::json )
+			std::printf( "{\n\t\"benchmarks\": [" );
+		else if( format == output_format::csv )
+			std::printf( "name,ns_per_op,ops_per_sec,allocs_per_op,allocated_bytes_per_op,bytes_per_cycle\n" );
+	}
+
+	void print_result( output_format format , const char* name , const bench::measurement& m , bool is_first ){
+		switch( format ){
+			case output_format::text:
+				std::printf( "%-48s %12.1f ns/op %14.0f ops/s %10.1f allocs/op %12.0f B/op" , name , m.ns_per_op , 1e9 / m.ns_per_op , m.allocations_per_op , m.allocated_bytes_per_op );
+				if( m.bytes_per_cycle )
+					std::printf( " %8.3f bytes/cycle" , m.bytes_per_cycle );
+				std::printf( "\n" );
+				break;
+			case output_format::json:
+				std::printf(
+					"%s\n\t\t{ \"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.1f, \"allocs_per_op\": %.3f, \"allocated_bytes_per_op\": %.1f, \"bytes_per_cycle\": %.4f }"
+					, is_first ? "" : "," , name , m.ns_per_op , 1e9 / m.ns_per_op , m.allocations_per_op , m.allocated_bytes_per_op , m.bytes_per_cycle
+				);
+				break;
+			case output_format::csv:
+				std::printf( "%s,%.3f,%.1f,%.3f,%.1f,%.4f\n" , name , m.ns_per_op , 1e9 / m.ns_per_op , m.allocations_per_op , m.allocated_bytes_per_op , m.bytes_per_cycle );
+				break;
+		}
+		std::fflush( stdout );
+	}
+
+	void print_footer( output_format format ){
+		if( format == output_format::json )
+			std::printf( "\n\t]\n}\n" );
+	}
+}
+
+//! Usage: bench [--json|--csv] [filter]
+int main( int argc , char** argv )
+{
+	const char*		filter = "";
+	output_format	format = output_format::text;
+
+	for( int i = 1 ; i < argc ; i++ ){
+		if( !std::strcmp( argv[i] , "--json" ) )
+			format = output_format::json;
+		else if( !std::strcmp( argv[i] , "--csv" ) )
+			format = output_format::csv;
+		else
+			filter = argv[i];
+	}
+
+	print_header( format );
+	bool is_first = true;
+	for( const bench::benchmark& b : bench::registry() ){
+		if( !std::strstr( b.name , filter ) )
+			continue;
+		print_result( format , b.name , bench::run( b ) , is_first );
+		is_first = false;
+	}
+	print_footer( format );
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_BATCH_H_
+#define _CPP_TYPENAME_PARSER_BATCH_H_
+
+#include "cpp-typename-parser.h"
+#include <thread>
+#include <exception>
+#include <system_error>
+
+// For mapped_file (std::min and std::max are parenthesized below, in case <windows.h> was included before without NOMINMAX)
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#define CPP_TYPENAME_PARSER_UNDEF_NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define CPP_TYPENAME_PARSER_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#ifdef CPP_TYPENAME_PARSER_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef CPP_TYPENAME_PARSER_UNDEF_NOMINMAX
+#endif
+#ifdef CPP_TYPENAME_PARSER_UNDEF_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef CPP_TYPENAME_PARSER_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace parser
+{
+	//! Result of parsing one entry of a batch
+	struct batch_entry
+	{
+		type	value;
+		bool	success; // Whether the entry was read completely as one valid type
+		
+		batch_entry() : value( nullptr ) , success( false ) {}
+	};
+	
+	struct batch_options
+	{
+		unsigned	num_threads = 0; // Number of threads to parse with (including the calling thread), 0 for one per hardware thread
+		size_t		chunk_size = 256; // Number of entries a thread claims at once
+	};
+	
+	namespace detail
+	{
+		//! Splits 'buffer' at every '\n' and '\0'. A separator at the very end does not start another entry
+		inline std::vector<std::string_view> split_entries( std::string_view buffer )
+		{
+			std::vector<std::string_view>	result;
+			const char*						begin = buffer.data();
+			const char*						end = begin + buffer.size();
+			
+			for( const char* pos = begin ; pos != end ; pos++ )
+				if( *pos == '\n' || *pos == '\0' ){
+					result.emplace_back( begin , pos - begin );
+					begin = pos + 1;
+				}
+			if( begin != end )
+				result.emplace_back( begin , end - begin );
+			return result;
+		}
+	}
+	
+	/**
+	 * Parses every entry of 'names' using several threads. Threads repeatedly claim the next chunk
+	 * of 'options.chunk_size' entries, so uneven entry lengths do not leave threads idle.
+	 * The results are in the order of 'names'.
+	 */
+	inline std::vector<batch_entry> parse_batch( const std::vector<std::string_view>& names , const batch_options& options = {} )
+	{
+		std::vector<batch_entry>	result( names.size() );
+		std::atomic<size_t>			next_chunk{ 0 };
+		size_t						chunk_size = (std::max<size_t>)( options.chunk_size , 1 );
+		size_t						num_chunks = ( names.size() + chunk_size - 1 ) / chunk_size;
+		unsigned					num_threads = options.num_threads ? options.num_threads : (std::max)( std::thread::hardware_concurrency() , 1u );
+		std::exception_ptr			error;
+		std::mutex					error_mutex;
+		
+		auto worker = [&](){
+			try{
+				for( size_t first ; ( first = next_chunk.fetch_add( chunk_size , std::memory_order_relaxed ) ) < names.size() ; ){
+					size_t last = (std::min)( first + chunk_size , names.size() );
+					for( size_t i = first ; i < last ; i++ )
+						result[i].success = result[i].value.parse( names[i] );
+				}
+			}
+			catch( ... ){
+				std::lock_guard<std::mutex> lock( error_mutex );
+				if( !error )
+					error = std::current_exception();
+				next_chunk = names.size(); // Stop all threads
+			}
+		};
+		
+		std::vector<std::thread> threads;
+		threads.reserve( (std::min<size_t>)( num_threads , num_chunks ) );
+		for( size_t i = 1 ; i < num_threads && i < num_chunks ; i++ )
+			threads.emplace_back( worker );
+		worker(); // The calling thread participates as well
+		for( std::thread& thread : threads )
+			thread.join();
+		
+		if( error )
+			std::rethrow_exception( error );
+		return result;
+	}
+	
+	//! Parses all newline- or NUL-separated type names within 'buffer'
+	inline std::vector<batch_entry> parse_batch( std::string_view buffer , const batch_options& options = {} ){
+		return parse_batch( detail::split_entries( buffer ) , options );
+	}
+	
+	/**
+	 * Read-only memory mapping of a whole file.
+	 * Throws std::system_error, if the file cannot be opened or mapped.
+	 */
+	class mapped_file
+	{
+	private:
+		
+		const char*		data_ = nullptr;
+		size_t			size_ = 0;
+		
+	public:
+		
+		explicit mapped_file( const char* path )
+		{
+			#if defined(_WIN32)
+			HANDLE file = CreateFileA( path , GENERIC_READ , FILE_SHARE_READ , nullptr , OPEN_EXISTING , FILE_ATTRIBUTE_NORMAL , nullptr );
+			if( file == INVALID_HANDLE_VALUE )
+				throw std::system_error( GetLastError() , std::system_category() , path );
+			LARGE_INTEGER file_size;
+			HANDLE mapping = nullptr;
+			if( GetFileSizeEx( file , &file_size ) && file_size.QuadPart > 0 ){
+				size_ = static_cast<size_t>( file_size.QuadPart );
+				mapping = CreateFileMappingA( file , nullptr , PAGE_READONLY , 0 , 0 , nullptr );
+				if( mapping ){
+					data_ = static_cast<const char*>( MapViewOfFile( mapping , FILE_MAP_READ , 0 , 0 , 0 ) );
+					CloseHandle( mapping );
+				}
+			}
+			DWORD error = GetLastError();
+			CloseHandle( file );
+			if( size_ && !data_ )
+				throw std::system_error( error , std::system_category() , path );
+			#else
+			int file = ::open( path , O_RDONLY );
+			if( file < 0 )
+				throw std::system_error( errno , std::generic_category() , path );
+			struct stat info;
+			if( ::fstat( file , &info ) == 0 && info.st_size > 0 ){
+				size_ = static_cast<size_t>( info.st_size );
+				void* data = ::mmap( nullptr , size_ , PROT_READ , MAP_PRIVATE , file , 0 );
+				if( data != MAP_FAILED )
+					data_ = static_cast<const char*>( data );
+			}
+			int error = errno;
+			::close( file );
+			if( size_ && !data_ )
+				throw std::system_error( error , std::generic_category() , path );
+			#endif
+		}
+		mapped_file( const mapped_file& ) = delete;
+		mapped_file& operator=( const mapped_file& ) = delete;
+		~mapped_file()
+		{
+			if( !data_ )
+				return;
+			#if defined(_WIN32)
+			UnmapViewOfFile( data_ );
+			#else
+			::munmap( const_cast<char*>( data_ ) , size_ );
+			#endif
+		}
+		
+		const char* data() const { return data_; }
+		size_t size() const { return size_; }
+		std::string_view view() const { return { data_ , size_ }; }
+	};
+	
+	//! Parses all newline- or NUL-separated type names within the file at 'path'
+	inline std::vector<batch_entry> parse_batch_file( const char* path , const batch_options& options = {} ){
+		mapped_file file( path );
+		return parse_batch( file.view() , options ); // Contents are interned, so the results do not refer to the mapping
+	}
+	
+} // namespace parser
+
+#endif
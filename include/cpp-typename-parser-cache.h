@@ -0,0 +1,173 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_CACHE_H_
+#define _CPP_TYPENAME_PARSER_CACHE_H_
+
+#include "cpp-typename-parser.h"
+
+namespace parser
+{
+	/**
+	 * Thread-safe, size bounded cache of parsed types, keyed by their string form.
+	 * Cached types are immutable and may be shared freely, they stay alive as long as they are referenced,
+	 * even if evicted in the meantime. The cache is split into shards (by hash of the name), each guarded
+	 * by its own lock, and evicts using the CLOCK (second chance) algorithm per shard.
+	 */
+	class type_cache
+	{
+	public:
+		
+		struct statistics
+		{
+			size_t	hits;
+			size_t	misses;
+			size_t	evictions;
+		};
+		
+		explicit type_cache( size_t capacity = 4096 , size_t num_shards = 16 )
+			: shards( std::max<size_t>( num_shards , 1 ) )
+			, shard_capacity( std::max<size_t>( ( capacity + shards.size() - 1 ) / shards.size() , 1 ) )
+		{
+			for( shard& sh : shards )
+				sh.slots.reserve( shard_capacity ); // Slots never move, since the index refers to their keys
+		}
+		type_cache( const type_cache& ) = delete;
+		type_cache& operator=( const type_cache& ) = delete;
+		
+		//! Returns the parsed type 'name', parsing it only if it is not in the cache yet
+		std::shared_ptr<const type> get( std::string_view name )
+		{
+			shard& sh = shards[ std::hash<std::string_view>()( name ) % shards.size() ];
+			{
+				std::lock_guard<std::mutex> lock( sh.mutex );
+				auto it = sh.index.find( name );
+				if( it != sh.index.end() ){
+					slot& s = sh.slots[it->second];
+					s.referenced = true;
+					sh.hits.fetch_add( 1 , std::memory_order_relaxed );
+					return s.value;
+				}
+			}
+			
+			// Parse outside of the lock, so that other lookups in this shard proceed meanwhile
+			sh.misses.fetch_add( 1 , std::memory_order_relaxed );
+			std::shared_ptr<const type> result = std::make_shared<const type>( name );
+			
+			std::lock_guard<std::mutex> lock( sh.mutex );
+			auto it = sh.index.find( name );
+			if( it != sh.index.end() ) // Inserted concurrently: Return the cached type, so that all callers share it
+				return sh.slots[it->second].value;
+			
+			size_t index;
+			if( sh.slots.size() < shard_capacity ){
+				index = sh.slots.size();
+				sh.slots.emplace_back();
+			}
+			else{
+				index = sh.evict();
+				sh.evictions.fetch_add( 1 , std::memory_order_relaxed );
+			}
+			slot& s = sh.slots[index];
+			s.key.assign( name.data() , name.size() );
+			s.value = result;
+			s.referenced = false;
+			sh.index.emplace( s.key , index );
+			return result;
+		}
+		
+		//! Returns the number of hits, misses and evictions since construction
+		statistics stats() const {
+			statistics result = { 0 , 0 , 0 };
+			for( const shard& sh : shards ){
+				result.hits += sh.hits.load( std::memory_order_relaxed );
+				result.misses += sh.misses.load( std::memory_order_relaxed );
+				result.evictions += sh.evictions.load( std::memory_order_relaxed );
+			}
+			return result;
+		}
+		
+		//! Returns the number of cached types
+		size_t size() const {
+			size_t result = 0;
+			for( const shard& sh : shards ){
+				std::lock_guard<std::mutex> lock( sh.mutex );
+				result += sh.index.size();
+			}
+			return result;
+		}
+		
+		//! Returns the maximum number of cached types
+		size_t capacity() const { return shard_capacity * shards.size(); }
+		
+		//! Removes all types from the cache
+		void clear(){
+			for( shard& sh : shards ){
+				std::lock_guard<std::mutex> lock( sh.mutex );
+				sh.index.clear();
+				sh.slots.clear();
+				sh.hand = 0;
+			}
+		}
+		
+	private:
+		
+		struct slot
+		{
+			std::string						key;
+			std::shared_ptr<const type>		value;
+			bool							referenced = false; // Set on every hit, cleared as the clock hand passes
+		};
+		
+		struct alignas(64) shard
+		{
+			mutable std::mutex								mutex;
+			std::unordered_map<std::string_view, size_t>	index; // Keys refer to slot::key
+			std::vector<slot>								slots;
+			size_t											hand = 0;
+			std::atomic<size_t>								hits{ 0 };
+			std::atomic<size_t>								misses{ 0 };
+			std::atomic<size_t>								evictions{ 0 };
+			
+			//! Frees the first slot not referenced since the hand last passed it and returns its index
+			size_t evict(){
+				while( slots[hand].referenced ){
+					slots[hand].referenced = false;
+					hand = ( hand + 1 ) % slots.size();
+				}
+				size_t result = hand;
+				hand = ( hand + 1 ) % slots.size();
+				index.erase( slots[result].key );
+				return result;
+			}
+		};
+		
+		std::vector<shard>	shards;
+		size_t				shard_capacity;
+	};
+	
+} // namespace parser
+
+#endif
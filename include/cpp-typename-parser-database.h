@@ -0,0 +1,605 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_DATABASE_H_
+#define _CPP_TYPENAME_PARSER_DATABASE_H_
+
+#include "cpp-typename-parser-batch.h" // For mapped_file
+#include <cstdio>
+
+/**
+ * Binary format of a type database (all integers little endian):
+ *
+ * <header>			:= MAGIC[8] VERSION:u32 NUM_STRINGS:u32 NUM_TYPES:u32 NUM_ENTRIES:u32
+ *					   STRING_OFFSETS:u32 STRING_DATA:u32 TYPE_OFFSETS:u32 TYPE_DATA:u32 ENTRIES:u32
+ * STRING_OFFSETS	:= u32[NUM_STRINGS+1], string i spans [offset[i],offset[i+1]) of STRING_DATA. String 0 is empty
+ * TYPE_OFFSETS		:= u32[NUM_TYPES], offset of the record of type i within TYPE_DATA
+ * ENTRIES			:= u32[NUM_ENTRIES], index of the type of every entry
+ * <type>			:= NUM_LAYERS:varint OUTERMOST:varint { <layer> }
+ * <layer>			:= KIND:u8 CONTENT:varint [ NUM_ARGUMENTS:varint { ARGUMENT:varint } ]
+ *
+ * Layers are stored from innermost to outermost, OUTERMOST is the offset of the last <layer> relative to the first
+ * (so questions about the outermost layer need not decode the others). KIND holds the layer_type in bits 0-2, 'const' in bit 3
+ * and 'volatile' in bit 4. CONTENT is a string index, ARGUMENT (only present for functions) a type index that is
+ * smaller than the index of the type referring to it. Equal types (including arguments) are stored once.
+ */
+
+namespace parser
+{
+	namespace detail
+	{
+		constexpr char			database_magic[8] = { 'C' , 'T' , 'P' , 'D' , 'B' , '\r' , '\n' , '\x1A' };
+		constexpr std::uint32_t	database_version = 2;
+		constexpr size_t		database_header_size = 8 + 9 * 4;
+		
+		inline void write_u32( std::string& output , std::uint32_t value ){
+			for( int i = 0 ; i < 4 ; i++ )
+				output += char( ( value >> ( 8 * i ) ) & 0xFF );
+		}
+		inline void write_varint( std::string& output , std::uint32_t value ){
+			for( ; value >= 0x80 ; value >>= 7 )
+				output += char( ( value & 0x7F ) | 0x80 );
+			output += char( value );
+		}
+		
+		inline std::uint32_t read_u32( const char* pos ){
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>( pos );
+			return std::uint32_t( bytes[0] ) | std::uint32_t( bytes[1] ) << 8 | std::uint32_t( bytes[2] ) << 16 | std::uint32_t( bytes[3] ) << 24;
+		}
+		//! Reads the varint at 'pos' into 'result'. Returns false, if it exceeds 'end' or 32 bits
+		inline bool read_varint( const char*& pos , const char* end , std::uint32_t& result ){
+			result = 0;
+			for( int shift = 0 ; pos != end && shift < 32 ; shift += 7 ){
+				unsigned char byte = static_cast<unsigned char>( *pos++ );
+				if( shift == 28 && byte > 0x0F )
+					return false;
+				result |= std::uint32_t( byte & 0x7F ) << shift;
+				if( byte < 0x80 )
+					return true;
+			}
+			return false;
+		}
+	}
+	
+	/**
+	 * Collects types and writes them in the binary database format read by 'type_database'.
+	 */
+	class type_database_writer
+	{
+	private:
+		
+		std::unordered_map<symbol_table::id_type, std::uint32_t>	string_indices;
+		std::vector<std::string_view>								strings{ std::string_view() };
+		std::unordered_map<type, std::uint32_t>						type_indices;
+		std::vector<std::uint32_t>									type_offsets;
+		std::string													type_data;
+		std::vector<std::uint32_t>									entries;
+		
+		std::uint32_t add_string( symbol str ){
+			if( str.empty() )
+				return 0;
+			auto result = string_indices.emplace( str.id() , std::uint32_t( strings.size() ) );
+			if( result.second )
+				strings.push_back( str.view() ); // Interned strings live as long as the process
+			return result.first->second;
+		}
+		
+		std::uint32_t add_type( const type& t )
+		{
+			auto it = type_indices.find( t );
+			if( it != type_indices.end() )
+				return it->second;
+			
+			// Arguments are written first, so their records precede the ones referring to them
+			std::vector<std::uint32_t> arguments;
+			for( const auto& lr : t )
+				for( const auto& arg : lr.arguments )
+					arguments.push_back( add_type( *arg ) );
+			
+			std::string		layers;
+			std::uint32_t	outermost = 0;
+			auto			next_argument = arguments.begin();
+			for( const auto& lr : t ){
+				outermost = std::uint32_t( layers.size() );
+				layers += char( int( lr.layer_type ) | lr.is_const << 3 | lr.is_volatile << 4 );
+				detail::write_varint( layers , add_string( lr.content ) );
+				if( lr.layer_type == layer_type::function ){
+					detail::write_varint( layers , std::uint32_t( lr.arguments.size() ) );
+					for( size_t i = 0 ; i < lr.arguments.size() ; i++ )
+						detail::write_varint( layers , *next_argument++ );
+				}
+			}
+			
+			std::uint32_t index = std::uint32_t( type_offsets.size() );
+			type_offsets.push_back( std::uint32_t( type_data.size() ) );
+			detail::write_varint( type_data , std::uint32_t( t.end() - t.begin() ) );
+			detail::write_varint( type_data , outermost );
+			type_data += layers;
+			type_indices.emplace( t , index );
+			return index;
+		}
+		
+	public:
+		
+		//! Adds 't' as the next entry of the database. Returns the index of the entry
+		size_t add( const type& t ){
+			entries.push_back( add_type( t ) );
+			return entries.size() - 1;
+		}
+		
+		//! Returns the number of entries added so far
+		size_t size() const { return entries.size(); }
+		
+		//! Returns the database in binary form
+		std::string serialize() const
+		{
+			size_t string_data_size = 0;
+			for( std::string_view str : strings )
+				string_data_size += str.size();
+			
+			std::uint32_t string_offsets = std::uint32_t( detail::database_header_size );
+			std::uint32_t string_data = std::uint32_t( string_offsets + 4 * ( strings.size() + 1 ) );
+			std::uint32_t type_offsets_pos = std::uint32_t( string_data + string_data_size );
+			std::uint32_t type_data_pos = std::uint32_t( type_offsets_pos + 4 * type_offsets.size() );
+			std::uint32_t entries_pos = std::uint32_t( type_data_pos + type_data.size() );
+			
+			std::string result;
+			result.reserve( entries_pos + 4 * entries.size() );
+			result.append( detail::database_magic , sizeof(detail::database_magic) );
+			for( std::uint32_t value : {
+				detail::database_version , std::uint32_t( strings.size() ) , std::uint32_t( type_offsets.size() ) , std::uint32_t( entries.size() )
+				, string_offsets , string_data , type_offsets_pos , type_data_pos , entries_pos
+			} )
+				detail::write_u32( result , value );
+			
+			std::uint32_t offset = 0;
+			for( std::string_view str : strings ){
+				detail::write_u32( result , offset );
+				offset += std::uint32_t( str.size() );
+			}
+			detail::write_u32( result , offset );
+			for( std::string_view str : strings )
+				result += str;
+			for( std::uint32_t type_offset : type_offsets )
+				detail::write_u32( result , type_offset );
+			result += type_data;
+			for( std::uint32_t entry : entries )
+				detail::write_u32( result , entry );
+			return result;
+		}
+		
+		//! Writes the database to the file at 'path'. Throws std::system_error on failure
+		void save( const char* path ) const
+		{
+			std::string data = serialize();
+			std::FILE* file = std::fopen( path , "wb" );
+			if( !file )
+				throw std::system_error( errno , std::generic_category() , path );
+			bool success = std::fwrite( data.data() , 1 , data.size() , file ) == data.size();
+			success = std::fclose( file ) == 0 && success;
+			if( !success )
+				throw std::system_error( errno , std::generic_category() , path );
+		}
+	};
+	
+	class type_database;
+	class database_type;
+	
+	//! Arguments of a function layer, i.e. a sequence of type indices
+	class database_argument_list
+	{
+	private:
+		
+		const type_database*	database = nullptr;
+		const char*				first = nullptr; // First ARGUMENT
+		const char*				last = nullptr; // End of the last ARGUMENT
+		std::uint32_t			count = 0;
+		std::uint32_t			owner = 0; // Index of the type, whose layer the arguments belong to
+		
+	public:
+		
+		class iterator
+		{
+		private:
+			
+			const type_database*	database;
+			const char*				pos;
+			std::uint32_t			owner;
+			
+		public:
+			
+			using iterator_category = std::input_iterator_tag;
+			using value_type = database_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = database_type;
+			
+			iterator( const type_database* database , const char* pos , std::uint32_t owner ) : database( database ) , pos( pos ) , owner( owner ) {}
+			
+			database_type operator*() const;
+			iterator& operator++();
+			bool operator==( const iterator& other ) const { return pos == other.pos; }
+			bool operator!=( const iterator& other ) const { return pos != other.pos; }
+		};
+		
+		database_argument_list() = default;
+		database_argument_list( const type_database* database , const char* first , const char* last , std::uint32_t count , std::uint32_t owner )
+			: database( database ) , first( first ) , last( last ) , count( count ) , owner( owner )
+		{}
+		
+		iterator begin() const { return iterator( database , first , owner ); }
+		iterator end() const { return iterator( database , last , owner ); }
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+	};
+	
+	/**
+	 * Read-only view of a type stored in a 'type_database', that decodes its layers directly from the
+	 * (mapped) database on access. Like type_view, but without parsing anything. Valid as long as the database.
+	 * Throws std::runtime_error, if the record of the type turns out to be malformed. Since arguments are references to other
+	 * records, which may be referenced many times, to_string() and to_type() also throw beyond grammar<type>::max_nesting_depth
+	 * nested arguments or once they expanded more than 'max_expansion_factor' layers per byte of the database.
+	 */
+	class database_type
+	{
+	public:
+		
+		using argument_list = database_argument_list;
+		
+		static constexpr size_t max_expansion_factor = 64;
+		
+		struct layer
+		{
+			parser::layer_type	layer_type;
+			std::string_view	content;
+			bool				is_const;
+			bool				is_volatile;
+			argument_list		arguments;
+		};
+		
+		//! Forward iterator decoding one layer after the other (from innermost to outermost)
+		class iterator;
+		using const_iterator = iterator;
+		
+		database_type( const type_database* database , std::uint32_t index , const char* record ) : database( database ) , record( record ) , index( index ) {}
+		
+		iterator begin() const;
+		iterator end() const;
+		
+		//! Returns the number of layers
+		size_t size() const;
+		
+		//! Convert this structure to a string representation (possibly to declare a variable 'name')
+		std::string to_string( std::string_view name = {} ) const {
+			std::string output;
+			to_string( output , name );
+			return output;
+		}
+		
+		//! Appends the string representation of this type (possibly declaring a variable 'name') to 'output'
+		void to_string( std::string& output , std::string_view name ) const;
+		
+		//! Copies this type out of the database
+		type to_type( type::allocator_type alloc = {} ) const;
+		
+	public: //! INFORMATION RETRIEVAL !//
+		
+		std::string_view get_datatype() const;
+		bool is_plain() const { return size() == 1 && front().layer_type == layer_type::type; }
+		bool is_lvalue_reference() const { return size() && back().layer_type == layer_type::lvalue; }
+		bool is_rvalue_reference() const { return size() && back().layer_type == layer_type::rvalue; }
+		bool is_array() const { return size() && back().layer_type == layer_type::array; }
+		bool is_pointer() const { return size() && back().layer_type == layer_type::pointer; }
+		bool is_member_pointer() const { return size() && back().layer_type == layer_type::member_pointer; }
+		bool is_const() const { return size() && back().is_const; }
+		bool is_volatile() const { return size() && back().is_volatile; }
+		bool is_void() const { return size() == 1 && front().content == "void"; }
+		
+	private:
+		
+		const type_database*	database;
+		const char*				record; // <type>
+		std::uint32_t			index; // Index of the type within the database
+		
+		layer front() const;
+		layer back() const; // Decodes the outermost layer only
+		
+		//! Reads NUM_LAYERS and OUTERMOST of the record. Returns the position of the first <layer>
+		const char* read_header( std::uint32_t& num_layers , std::uint32_t& outermost ) const;
+		
+		//! Decodes the <layer> at 'pos' of the type with the index 'owner' into 'result'. Returns the position after it
+		static const char* decode( const type_database* database , const char* pos , std::uint32_t owner , layer& result );
+		
+		//! Counts the layers expanded by to_string() and to_type() on this thread, including those of (nested) arguments
+		struct expansion
+		{
+			static inline thread_local int		depth = 0;
+			static inline thread_local size_t	remaining_layers = 0; // Set by the outermost type
+			
+			expansion( const type_database& database , size_t num_layers );
+			~expansion(){ depth--; }
+			expansion( const expansion& ) = delete;
+		};
+		
+		friend class type_database;
+	};
+	
+	class database_type::iterator
+	{
+	private:
+		
+		const type_database*	database;
+		const char*				pos; // Next <layer> to decode
+		std::uint32_t			remaining; // Number of layers not yet decoded
+		std::uint32_t			owner;
+		layer					current;
+		
+		void decode(){
+			if( remaining )
+				pos = database_type::decode( database , pos , owner , current );
+		}
+		
+	public:
+		
+		using iterator_category = std::input_iterator_tag;
+		using value_type = layer;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const layer*;
+		using reference = const layer&;
+		
+		iterator( const type_database* database , const char* pos , std::uint32_t remaining , std::uint32_t owner )
+			: database( database ) , pos( pos ) , remaining( remaining ) , owner( owner ) , current{}
+		{
+			decode();
+		}
+		
+		const layer& operator*() const { return current; }
+		const layer* operator->() const { return &current; }
+		iterator& operator++(){ remaining--; decode(); return *this; }
+		bool operator==( const iterator& other ) const { return remaining == other.remaining; }
+		bool operator!=( const iterator& other ) const { return remaining != other.remaining; }
+	};
+	
+	/**
+	 * Read-only collection of types in the binary format written by 'type_database_writer'.
+	 * The database is accessed in place (e.g. within a memory mapped file, whose pages are shared by all
+	 * processes mapping it), so opening it takes constant time: Only the header is validated on opening,
+	 * records, varints and indices are checked as they are accessed.
+	 * Throws std::runtime_error, if the header or an accessed record is malformed.
+	 */
+	class type_database
+	{
+	private:
+		
+		std::unique_ptr<mapped_file>	file;
+		std::string_view				data;
+		std::uint32_t					num_strings = 0;
+		std::uint32_t					num_types = 0;
+		std::uint32_t					num_entries = 0;
+		std::uint32_t					string_data_size = 0;
+		const char*						string_offsets = nullptr;
+		const char*						string_data = nullptr;
+		const char*						type_offsets = nullptr;
+		const char*						type_data = nullptr;
+		const char*						entries = nullptr;
+		
+		[[noreturn]] static void fail( const char* reason ){
+			throw std::runtime_error( std::string( "parser::type_database: " ) + reason );
+		}
+		
+		void open()
+		{
+			if( data.size() < detail::database_header_size || std::memcmp( data.data() , detail::database_magic , sizeof(detail::database_magic) ) != 0 )
+				fail( "not a type database" );
+			
+			const char* header = data.data() + sizeof(detail::database_magic);
+			if( detail::read_u32( header ) != detail::database_version )
+				fail( "unsupported version" );
+			num_strings = detail::read_u32( header + 4 );
+			num_types = detail::read_u32( header + 8 );
+			num_entries = detail::read_u32( header + 12 );
+			
+			// Checks, that the table of 'size' bytes at the offset stored at 'field' lies within the database
+			auto table = [&]( size_t field , std::uint64_t size ){
+				std::uint32_t offset = detail::read_u32( header + field );
+				if( offset < detail::database_header_size || offset + size > data.size() )
+					fail( "truncated" );
+				return data.data() + offset;
+			};
+			string_offsets = table( 16 , 4 * ( std::uint64_t( num_strings ) + 1 ) );
+			string_data_size = detail::read_u32( string_offsets + 4 * std::uint64_t( num_strings ) );
+			string_data = table( 20 , string_data_size );
+			type_offsets = table( 24 , 4 * std::uint64_t( num_types ) );
+			type_data = table( 28 , 0 );
+			entries = table( 32 , 4 * std::uint64_t( num_entries ) );
+		}
+		
+		//! Reads the varint at 'pos'
+		std::uint32_t read_varint( const char*& pos ) const {
+			std::uint32_t result;
+			if( !detail::read_varint( pos , data.data() + data.size() , result ) )
+				fail( "malformed record" );
+			return result;
+		}
+		
+		//! Reads the byte at 'pos'
+		unsigned char read_byte( const char*& pos ) const {
+			if( pos == data.data() + data.size() )
+				fail( "malformed record" );
+			return static_cast<unsigned char>( *pos++ );
+		}
+		
+		//! Returns 'pos' advanced by 'offset' bytes
+		const char* advance( const char* pos , std::uint32_t offset ) const {
+			if( offset > bytes_after( pos ) )
+				fail( "malformed record" );
+			return pos + offset;
+		}
+		
+		//! Returns the number of bytes from 'pos' to the end of the database
+		size_t bytes_after( const char* pos ) const { return data.data() + data.size() - pos; }
+		
+		friend class database_type;
+		friend class database_argument_list::iterator;
+		
+	public:
+		
+		//! Opens the database within 'buffer', which has to outlive the database
+		explicit type_database( std::string_view buffer ) : data( buffer ) { open(); }
+		
+		//! Maps the database file at 'path'. Throws std::system_error, if it cannot be mapped
+		explicit type_database( const char* path ) : file( new mapped_file( path ) ) , data( file->view() ) { open(); }
+		
+		//! Returns the number of entries
+		size_t size() const { return num_entries; }
+		
+		//! Returns the entry at 'index' (which has to be smaller than size())
+		database_type operator[]( size_t index ) const { return type_at( detail::read_u32( entries + 4 * index ) ); }
+		
+		//! Returns the type with the (internal) index 'index'
+		database_type type_at( std::uint32_t index ) const {
+			if( index >= num_types )
+				fail( "type index out of range" );
+			return database_type( this , index , advance( type_data , detail::read_u32( type_offsets + 4 * size_t( index ) ) ) );
+		}
+		
+		//! Returns the string with the (internal) index 'index'
+		std::string_view string_at( std::uint32_t index ) const {
+			if( index >= num_strings )
+				fail( "string index out of range" );
+			std::uint32_t begin = detail::read_u32( string_offsets + 4 * size_t( index ) );
+			std::uint32_t end = detail::read_u32( string_offsets + 4 * size_t( index ) + 4 );
+			if( begin > end || end > string_data_size )
+				fail( "malformed string offsets" );
+			return std::string_view( string_data + begin , end - begin );
+		}
+	};
+	
+	inline database_type database_argument_list::iterator::operator*() const {
+		const char* index_pos = pos;
+		std::uint32_t index = database->read_varint( index_pos );
+		if( index >= owner ) // Arguments precede the types referring to them, which also rules out cycles
+			type_database::fail( "malformed argument" );
+		return database->type_at( index );
+	}
+	inline database_argument_list::iterator& database_argument_list::iterator::operator++(){
+		database->read_varint( pos );
+		return *this;
+	}
+	
+	inline const char* database_type::decode( const type_database* database , const char* pos , std::uint32_t owner , layer& result )
+	{
+		unsigned char kind = database->read_byte( pos );
+		if( ( kind & 7 ) > int( layer_type::array ) || kind >= 32 )
+			type_database::fail( "malformed layer" );
+		result.layer_type = parser::layer_type( kind & 7 );
+		result.is_const = kind & 8;
+		result.is_volatile = kind & 16;
+		result.content = database->string_at( database->read_varint( pos ) );
+		result.arguments = argument_list();
+		if( result.layer_type == layer_type::function ){
+			std::uint32_t	num_arguments = database->read_varint( pos );
+			const char*		first = pos;
+			for( std::uint32_t i = 0 ; i < num_arguments ; i++ )
+				database->read_varint( pos );
+			result.arguments = argument_list( database , first , pos , num_arguments , owner );
+		}
+		return pos;
+	}
+	
+	inline const char* database_type::read_header( std::uint32_t& num_layers , std::uint32_t& outermost ) const {
+		const char* pos = record;
+		num_layers = database->read_varint( pos );
+		outermost = database->read_varint( pos );
+		if( num_layers > database->bytes_after( pos ) / 2 ) // Every <layer> takes at least two bytes
+			type_database::fail( "malformed record" );
+		return pos;
+	}
+	
+	inline size_t database_type::size() const {
+		std::uint32_t num_layers , outermost;
+		read_header( num_layers , outermost );
+		return num_layers;
+	}
+	
+	inline database_type::iterator database_type::begin() const {
+		std::uint32_t num_layers , outermost;
+		const char* pos = read_header( num_layers , outermost );
+		return iterator( database , pos , num_layers , index );
+	}
+	inline database_type::iterator database_type::end() const {
+		return iterator( database , nullptr , 0 , index );
+	}
+	
+	inline database_type::layer database_type::front() const { return *begin(); }
+	inline database_type::layer database_type::back() const {
+		std::uint32_t num_layers , outermost;
+		const char* pos = read_header( num_layers , outermost );
+		layer result;
+		decode( database , database->advance( pos , outermost ) , index , result );
+		return result;
+	}
+	
+	inline std::string_view database_type::get_datatype() const {
+		if( !size() )
+			return {};
+		layer lr = front();
+		return lr.layer_type == layer_type::type ? lr.content : std::string_view();
+	}
+	
+	inline database_type::expansion::expansion( const type_database& database , size_t num_layers )
+	{
+		if( depth++ == 0 )
+			remaining_layers = max_expansion_factor * database.data.size();
+		const char* error = depth > detail::grammar<type>::max_nesting_depth ? "arguments nested too deeply" : num_layers > remaining_layers ? "arguments expand too much" : nullptr;
+		if( error ){
+			depth--; // The destructor does not run
+			type_database::fail( error );
+		}
+		remaining_layers -= num_layers;
+	}
+	
+	inline void database_type::to_string( std::string& output , std::string_view name ) const {
+		expansion guard( *database , size() );
+		std::vector<layer> layers( begin() , end() );
+		detail::emitter::write( output , layers , name );
+	}
+	
+	inline type database_type::to_type( type::allocator_type alloc ) const
+	{
+		expansion guard( *database , size() );
+		type result( nullptr , alloc );
+		result.layers.reserve( size() );
+		for( const layer& lr : *this ){
+			result.layers.emplace_back( lr.layer_type , symbol( lr.content ) , lr.is_const , lr.is_volatile );
+			for( database_type arg : lr.arguments )
+				result.layers.back().arguments.push_back( std::allocate_shared<type>( alloc , arg.to_type( alloc ) ) );
+		}
+		return result;
+	}
+	
+} // namespace parser
+
+#endif
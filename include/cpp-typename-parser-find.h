@@ -0,0 +1,265 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_FIND_H_
+#define _CPP_TYPENAME_PARSER_FIND_H_
+
+#include "cpp-typename-parser.h"
+#include <cstring>
+
+namespace parser
+{
+	//! Type name found within a text by find_types()
+	struct found_type
+	{
+		size_t	offset; // Position of the name within the text
+		size_t	length; // Length of the name within the text
+		type	value;
+	};
+	
+	namespace detail
+	{
+		//! Checks, whether [begin,end) is "const" or "volatile"
+		inline bool is_cv_word( const char* begin , const char* end ){
+			std::string_view word( begin , end - begin );
+			return word == "const" || word == "volatile";
+		}
+		
+		//! Checks, whether the word [begin,end) within a line ending at 'line_end' may begin a type name worth parsing
+		inline bool is_type_candidate( const char* begin , const char* end , const char* line_end )
+		{
+			std::string_view word( begin , end - begin );
+			if( is_cv_word( begin , end ) || symbol_table::find_primitive( word ) != symbol_table::empty_id )
+				return true;
+			while( end != line_end && is_space( *end ) )
+				end++;
+			if( end == line_end )
+				return false;
+			switch( *end ){
+				case '<': case ':': case '*': case '&': case '(': case '[':
+					return true;
+				default:{ // "T const&"
+					std::string_view rest( end , line_end - end );
+					return rest.substr( 0 , 5 ) == "const" || rest.substr( 0 , 8 ) == "volatile";
+				}
+			}
+		}
+		
+		/**
+		 * Bracket structure of one line, determined in one pass over its brackets, so that type names are
+		 * only looked for within their enclosing brackets and before the next bracket without a partner:
+		 * A type name can contain neither, so each parse is bounded without scanning for matching brackets again.
+		 * Angle brackets are matched like find_matching_angle_bracket() does.
+		 */
+		class line_brackets
+		{
+		private:
+			
+			struct bracket
+			{
+				const char*	pos; // Opening bracket or closing bracket without partner
+				const char*	close; // Matching closing bracket, nullptr if there is no partner
+			};
+			
+			const char*				line_end = nullptr;
+			std::vector<bracket>	brackets; // Ordered by position
+			std::vector<size_t>		open; // Indices of the opening brackets without partner yet, while determining the structure
+			std::vector<const char*>	enclosing; // Closing brackets of the groups enclosing the last position queried
+			size_t					next = 0; // First bracket after the last position queried
+			size_t					next_barrier = 0; // First bracket without partner after the last position queried
+			
+		public:
+			
+			//! Determines the bracket structure of the line [begin,end)
+			void reset( const char* begin , const char* end )
+			{
+				line_end = end;
+				brackets.clear();
+				open.clear();
+				enclosing.clear();
+				next = next_barrier = 0;
+				
+				for( const char* pos = begin ; ( pos = find_bracket( pos , end ) ) != end ; pos++ ){
+					switch( *pos ){
+						case '(': case '[': case '{': case '<':
+							open.push_back( brackets.size() );
+							brackets.push_back( { pos , nullptr } );
+							break;
+						case '>':
+							if( !open.empty() && *brackets[open.back()].pos == '<' ){
+								brackets[open.back()].close = pos;
+								open.pop_back();
+							}
+							break; // Otherwise e.g. "->" or a comparison
+						default:{
+							char partner = *pos == ')' ? '(' : *pos == ']' ? '[' : '{';
+							while( !open.empty() && *brackets[open.back()].pos == '<' ) // Angle brackets within are no brackets after all
+								open.pop_back();
+							if( open.empty() || *brackets[open.back()].pos != partner )
+								brackets.push_back( { pos , nullptr } );
+							else{
+								brackets[open.back()].close = pos;
+								open.pop_back();
+							}
+						}
+					}
+				}
+			}
+			
+			//! Returns the end of the text, that a type name starting at 'pos' may span. 'pos' must not decrease between calls
+			const char* bound( const char* pos )
+			{
+				for( ; next != brackets.size() && brackets[next].pos < pos ; next++ ){
+					if( !brackets[next].close )
+						continue;
+					while( !enclosing.empty() && enclosing.back() < brackets[next].pos )
+						enclosing.pop_back();
+					enclosing.push_back( brackets[next].close );
+				}
+				while( !enclosing.empty() && enclosing.back() < pos )
+					enclosing.pop_back();
+				next_barrier = std::max( next_barrier , next );
+				while( next_barrier != brackets.size() && brackets[next_barrier].close )
+					next_barrier++;
+				
+				const char* result = enclosing.empty() ? line_end : enclosing.back();
+				return next_barrier != brackets.size() && brackets[next_barrier].pos < result ? brackets[next_barrier].pos : result;
+			}
+		};
+		
+		//! Checks, whether 't' is more than an ordinary word (e.g. "error" in "error: ...")
+		inline bool is_type_match( const type& t ){
+			if( !t.is_plain() || t.is_const() || t.is_volatile() )
+				return true;
+			const symbol& name = t.begin()->content;
+			return name.is_primitive() || name.view().find_first_of( " :<" ) != std::string_view::npos; // Only primitive types consist of multiple words
+		}
+	}
+	
+	/**
+	 * Finds all C++ type names within the free-form text 'text' (e.g. build logs, the output of 'nm -C' or crash reports)
+	 * and passes each as found_type to 'callback'. Returns the number of names found.
+	 * 
+	 * The text is classified 64 bytes at a time into a bit mask of identifier characters, from which the beginnings of
+	 * words are extracted without looking at the other characters again. Only words, that are followed by a declarator,
+	 * a template argument list, a qualification or cv-qualifier, or that are a primitive type or cv-qualifier, are passed
+	 * to type::parse_prefix(), all other words are skipped without being parsed. Type names never span multiple lines and
+	 * never overlap. Names that are ordinary words after all (e.g. "error" in "error: ") are not reported, names of
+	 * primitive types are (including "long" in "a long time"). Numbers are skipped as a whole, so "0x10" does not yield "x10".
+	 * 
+	 * Each parse is bounded by the brackets enclosing the candidate and by the next bracket without partner (see
+	 * detail::line_brackets), and cv-qualifiers following a candidate, that failed to parse, are not tried again:
+	 * They would fail the same way. Therefore every line is read a bounded number of times, however it looks.
+	 */
+	template<typename Callback>
+	size_t find_types( std::string_view text , Callback&& callback )
+	{
+		const char*		begin = text.data();
+		const char*		end = begin + text.size();
+		const char*		pos = begin; // Everything before 'pos' belongs to a type name already found
+		const char*		covered = begin; // Everything before 'covered' was read by a failed parse already
+		const char*		line_end = begin; // End of the line of the last candidate
+		bool			line_scanned = false; // Whether 'brackets' refers to the line ending at 'line_end'
+		std::uint64_t	carry = 0; // Whether the last character of the previous block is an identifier character
+		size_t			num_found = 0;
+		
+		detail::line_brackets brackets;
+		
+		for( const char* block = begin ; block < end ; block += 64 )
+		{
+			std::uint64_t mask;
+			if( end - block >= 64 )
+				mask = detail::identifier_mask64( block );
+			else{
+				char tail[64] = {}; // Padded with non-identifier characters
+				std::memcpy( tail , block , end - block );
+				mask = detail::identifier_mask64( tail );
+			}
+			
+			std::uint64_t starts = mask & ~( mask << 1 | carry );
+			carry = mask >> 63;
+			
+			for( ; starts ; starts &= starts - 1 )
+			{
+				int			index = detail::scan::count_trailing_zeros( starts );
+				const char*	word = block + index;
+				if( word < pos || word < covered || !detail::is_identifier_start( *word ) )
+					continue;
+				
+				std::uint64_t	rest = ~mask >> index;
+				const char*		word_end = rest ? word + detail::scan::count_trailing_zeros( rest ) : detail::skip_identifier( block + 64 , end );
+				
+				if( line_end <= word ){
+					line_end = static_cast<const char*>( std::memchr( word , '\n' , end - word ) );
+					if( !line_end )
+						line_end = end;
+					line_scanned = false;
+				}
+				
+				if( !detail::is_type_candidate( word , word_end , line_end ) )
+					continue;
+				
+				if( !line_scanned ){
+					brackets.reset( word , line_end ); // Brackets before the first candidate do not matter
+					line_scanned = true;
+				}
+				const char* bound = brackets.bound( word );
+				
+				const char* start = word;
+				if( start - pos >= 2 && start[-1] == ':' && start[-2] == ':' && ( start - begin == 2 || ( start[-3] != ':' && !detail::is_identifier_char( start[-3] ) ) ) )
+					start -= 2; // Global qualification
+				
+				found_type result{ size_t( start - begin ) , 0 , type( nullptr ) };
+				result.length = result.value.parse_prefix( std::string_view( start , bound - start ) );
+				if( result.length && detail::is_type_match( result.value ) ){
+					pos = start + result.length;
+					callback( std::move(result) );
+					num_found++;
+				}
+				else if( !result.length && detail::is_cv_word( word , word_end ) ){
+					// Skip the following cv-qualifiers: Parsing from there reads the same text after them
+					for( covered = word_end ; ; covered = detail::skip_identifier( covered , bound ) ){
+						while( covered != bound && detail::is_space( *covered ) )
+							covered++;
+						if( !detail::is_cv_word( covered , detail::skip_identifier( covered , bound ) ) )
+							break;
+					}
+				}
+			}
+		}
+		
+		return num_found;
+	}
+	
+	//! Returns all C++ type names within the free-form text 'text' (see find_types( text , callback ))
+	inline std::vector<found_type> find_types( std::string_view text ){
+		std::vector<found_type> result;
+		find_types( text , [&result]( found_type&& found ){ result.push_back( std::move(found) ); } );
+		return result;
+	}
+	
+} // namespace parser
+
+#endif
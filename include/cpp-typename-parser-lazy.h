@@ -0,0 +1,295 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_LAZY_H_
+#define _CPP_TYPENAME_PARSER_LAZY_H_
+
+#include "cpp-typename-parser.h"
+#include <optional>
+
+namespace parser
+{
+	namespace detail
+	{
+		//! Kind and cv-qualifiers of the outermost layer of a type name, as far as they can be told from the end of the name
+		struct outermost_shape
+		{
+			bool		known = false;
+			layer_type	kind = layer_type::type;
+			bool		is_const = false;
+			bool		is_volatile = false;
+		};
+		
+		//! Checks, whether [begin,end) ends with the word 'word'
+		inline bool ends_with_word( const char* begin , const char* end , std::string_view word ){
+			size_t length = end - begin;
+			return
+				length >= word.size()
+				&& std::string_view( end - word.size() , word.size() ) == word
+				&& ( length == word.size() || !is_identifier_char( end[-1 - int( word.size() )] ) )
+			;
+		}
+		
+		//! Returns the opening bracket matching the closing bracket at end[-1] (searching backwards from there) or 'begin'
+		inline const char* find_matching_open_bracket( const char* begin , const char* end , char open )
+		{
+			char	close = end[-1];
+			int		nesting = 0;
+			for( const char* pos = end - 1 ; pos != begin ; ){
+				pos--;
+				if( *pos == close )
+					nesting++;
+				else if( *pos == open && nesting-- == 0 )
+					return pos;
+			}
+			return begin;
+		}
+		
+		/**
+		 * Determines the outermost layer of the type name [begin,end) by looking at its end only:
+		 *  -  Trailing cv-qualifiers are skipped, then a '*' (after '::' for member pointers), '&' or '&&' is the outermost layer.
+		 *  -  A name ending with an identifier or template argument list consists of a basic data type only.
+		 *  -  Trailing parameter lists or array extents, that follow a parenthesized declarator (e.g. "(*)" in "void (*)(int)"),
+		 *     are skipped and the declarator is looked at instead. Other arrays end with their extents.
+		 * Everything else (e.g. plain function types) is not 'known'.
+		 * The result is only guaranteed to match the parsed type, if all of [begin,end) is one valid type.
+		 */
+		inline outermost_shape scan_outermost_shape( const char* begin , const char* end , int depth = 0 )
+		{
+			outermost_shape	result;
+			auto			trim = [&]{ while( end != begin && is_space( end[-1] ) ) end--; };
+			
+			for( trim() ; ; trim() ){
+				if( ends_with_word( begin , end , "const" ) ){
+					result.is_const = true;
+					end -= 5;
+				}
+				else if( ends_with_word( begin , end , "volatile" ) ){
+					result.is_volatile = true;
+					end -= 8;
+				}
+				else
+					break;
+			}
+			if( begin == end || depth >= grammar<type>::max_nesting_depth )
+				return result;
+			
+			switch( end[-1] ){
+				case '*':
+					end--;
+					trim();
+					result.kind = end - begin >= 2 && end[-1] == ':' && end[-2] == ':' ? layer_type::member_pointer : layer_type::pointer;
+					result.known = true;
+					return result;
+				case '&':
+					result.kind = end - begin >= 2 && end[-2] == '&' ? layer_type::rvalue : layer_type::lvalue;
+					result.known = !result.is_const && !result.is_volatile; // References are never cv-qualified
+					return result;
+				case ')': // Parameters (the trailing cv-qualifiers belonging to the function layer)
+				case ']': // Array extents
+				{
+					if( end[-1] == ']' && ( result.is_const || result.is_volatile ) )
+						return {};
+					bool is_function = end[-1] == ')';
+					do{
+						char open = end[-1] == ')' ? '(' : '[';
+						end = find_matching_open_bracket( begin , end , open );
+						if( *end != open )
+							return {};
+						trim();
+					}while( end != begin && end[-1] == ']' );
+					
+					if( end != begin && end[-1] == ')' ){ // Parenthesized declarator
+						const char* group_begin = find_matching_open_bracket( begin , end , '(' );
+						if( *group_begin != '(' )
+							return {};
+						result = scan_outermost_shape( group_begin + 1 , end - 1 , depth + 1 );
+						result.known &= result.kind != layer_type::type;
+						return result;
+					}
+					result = {};
+					result.kind = layer_type::array;
+					result.known = !is_function && end != begin; // Plain function types are not known
+					return result;
+				}
+				case '>':
+					break;
+				default:
+					if( !is_identifier_char( end[-1] ) )
+						return result;
+			}
+			
+			// A basic data type: cv-qualifiers may appear anywhere outside of its template argument lists
+			for( const char* pos = begin ; pos != end ; ){
+				if( *pos == '<' ){
+					pos = find_matching_angle_bracket( pos , end );
+					if( pos != end )
+						pos++;
+				}
+				else if( is_identifier_start( *pos ) ){
+					const char* word_end = skip_identifier( pos , end );
+					std::string_view word( pos , word_end - pos );
+					result.is_const |= word == "const";
+					result.is_volatile |= word == "volatile";
+					pos = word_end;
+				}
+				else
+					pos++;
+			}
+			result.kind = layer_type::type;
+			result.known = true;
+			return result;
+		}
+		
+		inline outermost_shape scan_outermost_shape( std::string_view input ){
+			return scan_outermost_shape( input.data() , input.data() + input.size() );
+		}
+	}
+	
+	/**
+	 * Type, that keeps its name as text and only parses it once its layers are needed (for iteration, to_string(),
+	 * comparison or modification). Until then, questions about the outermost layer are answered by looking at
+	 * the end of the name (see detail::scan_outermost_shape()) and get_datatype() only reads the basic data type.
+	 * Answers equal those of 'type', if the whole name is one valid type.
+	 * Const member functions may parse the name and are therefore not safe to call concurrently on one object.
+	 */
+	class lazy_type
+	{
+	private:
+		
+		std::string					source;
+		mutable std::optional<type>	parsed;
+		
+		detail::outermost_shape shape() const {
+			return parsed ? detail::outermost_shape{} : detail::scan_outermost_shape( source );
+		}
+	
+	public:
+		
+		//! Ctor from C++ typename in string form (which is copied, but not parsed)
+		explicit lazy_type( std::string_view input ) : source( input ) {}
+		explicit lazy_type( const char* input ) : source( input ) {}
+		explicit lazy_type( std::string input ) : source( std::move(input) ) {}
+		
+		//! Returns the parsed type, parsing it on the first call
+		const type& get() const {
+			if( !parsed )
+				parsed.emplace( source );
+			return *parsed;
+		}
+		
+		//! Returns the parsed type for modification, parsing it on the first call
+		type& get(){
+			if( !parsed )
+				parsed.emplace( source );
+			return *parsed;
+		}
+		
+		//! Checks, whether the name has been parsed already
+		bool is_parsed() const { return parsed.has_value(); }
+		
+		//! Returns the name as passed to the constructor
+		std::string_view source_text() const { return source; }
+		
+		//! Comparison operator
+		bool operator==( const lazy_type& other ) const { return source == other.source || get() == other.get(); }
+		bool operator!=( const lazy_type& other ) const { return !( *this == other ); }
+		
+		//! Iterator Interface
+		type::const_iterator begin() const { return get().begin(); }
+		type::const_iterator end() const { return get().end(); }
+		
+		//! Convert this structure to a string representation (possibly to declare a variable 'name')
+		std::string to_string( std::string_view name = {} ) const { return get().to_string( name ); }
+		void to_string( std::string& output , std::string_view name ) const { get().to_string( output , name ); }
+	
+	public: //! MODIFIERS (Parsing the name first) !//
+	
+		void set_datatype( type t ){ get().set_datatype( std::move(t) ); }
+		void add_const(){ get().add_const(); }
+		void add_volatile(){ get().add_volatile(); }
+		void add_array( int extent = -1 ){ get().add_array( extent ); }
+		void add_function( std::vector<std::shared_ptr<type>> parameters = {} ){ get().add_function( std::move(parameters) ); }
+		void remove_const(){ get().remove_const(); }
+		void remove_volatile(){ get().remove_volatile(); }
+		void remove_reference(){ get().remove_reference(); }
+		void remove_pointer(){ get().remove_pointer(); }
+	
+	public: //! INFORMATION RETRIEVAL (Without parsing the name, where possible) !//
+	
+		std::string get_datatype() const
+		{
+			if( parsed )
+				return parsed->get_datatype();
+			
+			// Only read the basic data type, which is the innermost layer (unless parsing fails)
+			type basic( nullptr );
+			detail::cursor input( source );
+			detail::grammar<type>::add_layer( basic , layer_type::type );
+			detail::grammar<type>::skip_spaces( input );
+			if( !detail::grammar<type>::node_basic_type( basic , input ) )
+				return std::string();
+			return std::string( basic.layers.front().content );
+		}
+		bool is_plain() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.kind == layer_type::type : get().is_plain();
+		}
+		bool is_lvalue_reference() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.kind == layer_type::lvalue : get().is_lvalue_reference();
+		}
+		bool is_rvalue_reference() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.kind == layer_type::rvalue : get().is_rvalue_reference();
+		}
+		bool is_array() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.kind == layer_type::array : get().is_array();
+		}
+		bool is_pointer() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.kind == layer_type::pointer : get().is_pointer();
+		}
+		bool is_member_pointer() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.kind == layer_type::member_pointer : get().is_member_pointer();
+		}
+		bool is_const() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.is_const : get().is_const();
+		}
+		bool is_volatile() const {
+			detail::outermost_shape s = shape();
+			return s.known ? s.is_volatile : get().is_volatile();
+		}
+		bool is_void() const {
+			return parsed ? parsed->is_void() : is_plain() && get_datatype() == "void";
+		}
+	};
+
+} // namespace parser
+
+#endif
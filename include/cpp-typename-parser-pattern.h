@@ -0,0 +1,563 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_PATTERN_H_
+#define _CPP_TYPENAME_PARSER_PATTERN_H_
+
+#include "cpp-typename-parser.h"
+#include <functional> // For std::hash
+
+/**
+ * Pattern language (see pattern_set):
+ *
+ * A pattern is a type name, in which placeholders may stand for parts of the type:
+ *  -  '$T' in place of a basic data type matches any type and captures it as T (e.g. "$T const&", "std::vector<$T>").
+ *     cv-qualifiers written next to it must be present and are not part of the capture ("$T const*" captures "int" from "const int*").
+ *  -  '$C' as the class of a member pointer or the extent of an array (e.g. "$T $C::*", "char[$N]").
+ *  -  '$A...' as the last function parameter or template argument matches any number of them (e.g. "$R (*)($A...)").
+ *  -  '$' and '$...' match the same without capturing anything.
+ * A name used twice within one pattern must capture equal values (e.g. "std::pair<$T, $T>").
+ * Template arguments can only contain placeholders in the last component of a name ("ns::A<int>::B<$T>", not "ns::A<$T>::B").
+ */
+
+namespace parser
+{
+	//! Value captured by a placeholder
+	struct pattern_capture
+	{
+		symbol					name; // Name of the placeholder (without '$')
+		template_argument_list	values; // One value, or any number for '$A...'
+	};
+	
+	//! Result of matching a type against a pattern_set
+	struct pattern_match
+	{
+		size_t							pattern; // Index of the pattern within the pattern_set
+		std::vector<pattern_capture>	captures;
+		
+		//! Returns the values captured by placeholder 'name' or nullptr
+		const template_argument_list* operator[]( std::string_view name ) const {
+			for( const pattern_capture& capture : captures )
+				if( capture.name == name )
+					return &capture.values;
+			return nullptr;
+		}
+		
+		//! Returns the type captured by placeholder 'name' or nullptr, if it captured an expression or nothing
+		const type* get_type( std::string_view name ) const {
+			const template_argument_list* values = (*this)[name];
+			return values && values->size() == 1 ? values->front().value.get() : nullptr;
+		}
+	};
+	
+	namespace detail
+	{
+		//! Placeholders are renamed to identifiers with this prefix, so the grammar reads them as names
+		constexpr std::string_view placeholder_prefix = "__pattern_";
+		constexpr std::string_view pack_placeholder_prefix = "__pattern_pack_";
+		
+		struct pattern_layer;
+		
+		//! Pattern of a whole type (e.g. of a function parameter or template argument)
+		struct compiled_pattern
+		{
+			std::vector<pattern_layer>	layers; // Outermost first
+			bool						is_open = false; // Whether the innermost part is a placeholder, that matches all remaining layers
+			bool						is_const = false; // cv-qualifiers required by the placeholder
+			bool						is_volatile = false;
+			symbol						name; // Name of the placeholder
+			
+			//! Checks, whether this pattern is nothing but a placeholder (which also matches non-type template arguments)
+			bool is_placeholder() const { return is_open && layers.empty() && !is_const && !is_volatile; }
+		};
+		
+		//! Pattern of a function parameter or template argument
+		struct pattern_argument
+		{
+			compiled_pattern	pattern; // If it is a type
+			symbol				expression; // If it is a non-type template argument
+			bool				is_type = true;
+		};
+		
+		//! Pattern of one layer
+		struct pattern_layer
+		{
+			enum content_kind : unsigned char{
+				exact // Content must be equal
+				, placeholder // Content is captured
+				, template_id // Content must be 'content' followed by template arguments matching 'arguments'
+			};
+			
+			layer_type						kind = layer_type::type;
+			bool							is_const = false;
+			bool							is_volatile = false;
+			content_kind					how = exact;
+			symbol							content; // Content, template name or placeholder name
+			std::vector<pattern_argument>	arguments; // Function parameters or template arguments
+			bool							has_pack = false; // Whether 'arguments' are followed by '$A...'
+			symbol							pack_name;
+			std::string						signature; // Equal for equal layer patterns
+			
+			//! Checks, whether the layer can be looked up by kind, cv-qualifiers and content alone
+			bool is_exact() const { return how == exact && kind != layer_type::function; }
+		};
+		
+		//! Key of a layer within pattern_node::exact
+		inline std::uint64_t pattern_layer_key( layer_type kind , bool is_const , bool is_volatile , symbol content ){
+			return std::uint64_t( kind ) | std::uint64_t( is_const ) << 3 | std::uint64_t( is_volatile ) << 4 | std::uint64_t( content.id() ) << 8;
+		}
+		
+		//! Returns the name in front of the final template argument list of 'content' (e.g. "std::vector" for "std::vector<int>") or an empty view
+		inline std::string_view template_name( std::string_view content ){
+			const char* open = find_final_template_id( content );
+			return open ? std::string_view( content.data() , open - content.data() ) : std::string_view();
+		}
+		
+		//! Node of the decision tree of a pattern_set. Edges lead from the outermost layer of a type inwards
+		struct pattern_node
+		{
+			struct open_end
+			{
+				std::uint32_t	pattern;
+				bool			is_const;
+				bool			is_volatile;
+				symbol			name;
+			};
+			
+			std::unordered_map<std::uint64_t, std::uint32_t>					exact; // Layer key -> child node
+			std::vector<std::pair<pattern_layer, std::uint32_t>>				generic; // Other layer patterns -> child node
+			std::unordered_map<std::string_view, std::vector<std::uint32_t>>	generic_by_name; // Template name -> indices into 'generic'
+			std::vector<std::uint32_t>											generic_other; // Indices into 'generic' without template name
+			std::vector<std::uint32_t>											ends; // Patterns, that end here
+			std::vector<open_end>												open_ends; // Patterns, whose remaining layers are matched by a placeholder
+		};
+	}
+	
+	/**
+	 * Set of type patterns (see the pattern language above), compiled into one decision tree:
+	 * Starting at the outermost layer, layers without placeholders are looked up by kind, cv-qualifiers and interned
+	 * content in a hash map; other layers are tested only against the patterns sharing their template name.
+	 * Thus matching a type against the whole set touches each of its layers about once, however many patterns there are.
+	 */
+	class pattern_set
+	{
+	private:
+		
+		using captures = std::vector<pattern_capture>;
+		
+		std::vector<detail::pattern_node>	nodes{ 1 }; // nodes[0] is the root
+		std::vector<std::string>			sources;
+		
+		[[noreturn]] static void fail( std::string_view pattern , const char* reason ){
+			throw std::invalid_argument( "parser::pattern_set: " + std::string( reason ) + " in pattern '" + std::string( pattern ) + "'" );
+		}
+		
+		//! Replaces '$A...' by pack_placeholder_prefix+"A" and '$T' by placeholder_prefix+"T"
+		static std::string rename_placeholders( std::string_view pattern )
+		{
+			std::string result;
+			for( size_t pos = 0 ; pos < pattern.size() ; ){
+				if( pattern[pos] != '$' ){
+					result += pattern[pos++];
+					continue;
+				}
+				size_t name_end = pos + 1;
+				while( name_end < pattern.size() && detail::is_identifier_char( pattern[name_end] ) )
+					name_end++;
+				std::string_view name = pattern.substr( pos + 1 , name_end - pos - 1 );
+				if( pattern.substr( name_end , 3 ) == "..." ){
+					result += detail::pack_placeholder_prefix;
+					name_end += 3;
+				}
+				else
+					result += detail::placeholder_prefix;
+				result += name;
+				pos = name_end;
+			}
+			return result;
+		}
+		
+		//! Checks, whether 'content' is a renamed placeholder. Sets 'name' and 'is_pack' accordingly
+		static bool is_placeholder( symbol content , symbol& name , bool& is_pack ){
+			std::string_view view = content.view();
+			if( view.substr( 0 , detail::placeholder_prefix.size() ) != detail::placeholder_prefix )
+				return false;
+			if( std::any_of( view.begin() , view.end() , []( char c ){ return !detail::is_identifier_char( c ); } ) )
+				return false;
+			is_pack = view.substr( 0 , detail::pack_placeholder_prefix.size() ) == detail::pack_placeholder_prefix;
+			name = view.substr( is_pack ? detail::pack_placeholder_prefix.size() : detail::placeholder_prefix.size() );
+			return true;
+		}
+		
+		static bool contains_placeholder( std::string_view text ){
+			return text.find( detail::placeholder_prefix ) != std::string_view::npos;
+		}
+		
+		//! Compiles the pattern 't'. Sets 'is_pack', if it is a '$A...' (which is only valid as last argument)
+		static detail::compiled_pattern compile( const type& t , std::string_view source , bool* is_pack = nullptr )
+		{
+			detail::compiled_pattern	result;
+			bool						pack = false;
+			size_t						num_layers = t.end() - t.begin();
+			
+			if( num_layers && is_placeholder( t.begin()->content , result.name , pack ) ){
+				result.is_open = true;
+				result.is_const = t.begin()->is_const;
+				result.is_volatile = t.begin()->is_volatile;
+				if( pack && ( num_layers > 1 || result.is_const || result.is_volatile || !is_pack ) )
+					fail( source , "misplaced '...'" );
+			}
+			if( is_pack )
+				*is_pack = pack;
+			
+			for( size_t i = num_layers ; i-- > size_t( result.is_open ) ; )
+				result.layers.push_back( compile_layer( t.begin()[i] , source ) );
+			return result;
+		}
+		
+		//! Compiles the function parameters or template arguments 'arguments' into 'dest'
+		template<typename Arguments, typename Get>
+		static void compile_arguments( detail::pattern_layer& dest , const Arguments& arguments , Get&& get , std::string_view source )
+		{
+			for( const auto& arg : arguments ){
+				if( dest.has_pack )
+					fail( source , "misplaced '...'" );
+				const template_argument& value = get( arg );
+				detail::pattern_argument result;
+				result.is_type = value.is_type();
+				if( result.is_type ){
+					bool is_pack = false;
+					result.pattern = compile( *value.value , source , &is_pack );
+					if( is_pack ){
+						dest.has_pack = true;
+						dest.pack_name = result.pattern.name;
+						continue;
+					}
+				}
+				else if( contains_placeholder( value.expression.view() ) )
+					fail( source , "placeholder within an expression" );
+				else
+					result.expression = value.expression;
+				dest.arguments.push_back( std::move(result) );
+			}
+		}
+		
+		static detail::pattern_layer compile_layer( const type::layer& lr , std::string_view source )
+		{
+			detail::pattern_layer	result;
+			bool					is_pack = false;
+			std::string_view		content = lr.content.view();
+			
+			result.kind = lr.layer_type;
+			result.is_const = lr.is_const;
+			result.is_volatile = lr.is_volatile;
+			result.content = lr.content;
+			result.signature = std::to_string( int( lr.layer_type ) | lr.is_const << 3 | lr.is_volatile << 4 ) + ' ' + std::string( content );
+			
+			if( lr.layer_type == layer_type::function ){
+				compile_arguments( result , lr.arguments , []( const std::shared_ptr<type>& param ){ return template_argument{ param , {} }; } , source );
+				for( const auto& param : lr.arguments )
+					result.signature += ',' + param->to_string();
+			}
+			else if( is_placeholder( lr.content , result.content , is_pack ) ){
+				if( is_pack )
+					fail( source , "misplaced '...'" );
+				result.how = detail::pattern_layer::placeholder;
+			}
+			else if( contains_placeholder( content ) ){
+				std::string_view name = detail::template_name( content );
+				if( name.empty() || contains_placeholder( name ) )
+					fail( source , "placeholder outside of the last template argument list" );
+				result.how = detail::pattern_layer::template_id;
+				result.content = symbol( name );
+				compile_arguments( result , lr.content.template_arguments() , []( const template_argument& arg ) -> const template_argument& { return arg; } , source );
+			}
+			return result;
+		}
+		
+		//! Adds 'p' as pattern 'index' to the decision tree
+		void insert( const detail::compiled_pattern& p , std::uint32_t index )
+		{
+			std::uint32_t node = 0;
+			for( const detail::pattern_layer& lr : p.layers ){
+				std::uint32_t next = std::uint32_t( nodes.size() );
+				if( lr.is_exact() ){
+					auto result = nodes[node].exact.emplace( detail::pattern_layer_key( lr.kind , lr.is_const , lr.is_volatile , lr.content ) , next );
+					if( !result.second ){
+						node = result.first->second;
+						continue;
+					}
+				}
+				else{
+					auto& generic = nodes[node].generic;
+					auto it = std::find_if( generic.begin() , generic.end() , [&lr]( const auto& edge ){ return edge.first.signature == lr.signature; } );
+					if( it != generic.end() ){
+						node = it->second;
+						continue;
+					}
+					std::uint32_t edge = std::uint32_t( generic.size() );
+					generic.emplace_back( lr , next );
+					if( lr.how == detail::pattern_layer::template_id )
+						nodes[node].generic_by_name[lr.content.view()].push_back( edge );
+					else
+						nodes[node].generic_other.push_back( edge );
+				}
+				nodes.emplace_back();
+				node = next;
+			}
+			if( p.is_open )
+				nodes[node].open_ends.push_back( { index , p.is_const , p.is_volatile , p.name } );
+			else
+				nodes[node].ends.push_back( index );
+		}
+		
+	private: //! MATCHING !//
+		
+		static bool equal( const template_argument& lhs , const template_argument& rhs ){
+			if( lhs.is_type() != rhs.is_type() )
+				return false;
+			return lhs.is_type() ? lhs.value == rhs.value || *lhs.value == *rhs.value : lhs.expression == rhs.expression;
+		}
+		
+		//! Adds a capture. Fails, if 'name' captured a different value before
+		static bool capture( captures& caps , symbol name , template_argument_list values )
+		{
+			if( name.empty() )
+				return true;
+			for( const pattern_capture& existing : caps )
+				if( existing.name == name )
+					return std::equal( existing.values.begin() , existing.values.end() , values.begin() , values.end() , []( const template_argument& lhs , const template_argument& rhs ){ return equal( lhs , rhs ); } );
+			caps.push_back( { name , std::move(values) } );
+			return true;
+		}
+		
+		//! Captures the innermost 'num_layers' layers of 't' for the placeholder of 'p' (without the cv-qualifiers written in the pattern)
+		static bool capture_inner( captures& caps , const type& t , size_t num_layers , symbol name , bool is_const , bool is_volatile )
+		{
+			const type::layer& outermost = t.layers[num_layers - 1];
+			if( ( is_const && !outermost.is_const ) || ( is_volatile && !outermost.is_volatile ) )
+				return false;
+			if( name.empty() )
+				return true;
+			type result( nullptr );
+			result.layers.reserve( num_layers );
+			for( size_t i = 0 ; i < num_layers ; i++ )
+				result.layers.emplace_back( t.layers[i] );
+			result.layers.back().is_const = outermost.is_const && !is_const;
+			result.layers.back().is_volatile = outermost.is_volatile && !is_volatile;
+			return capture( caps , name , { template_argument{ std::make_shared<const type>( std::move(result) ) , {} } } );
+		}
+		
+		static bool match_argument( const detail::pattern_argument& p , const template_argument& arg , captures& caps )
+		{
+			if( !p.is_type )
+				return !arg.is_type() && arg.expression == p.expression;
+			if( p.pattern.is_placeholder() )
+				return capture( caps , p.pattern.name , { arg } );
+			return arg.is_type() && match_type( p.pattern , *arg.value , caps );
+		}
+		
+		//! Matches 'num' arguments, 'get(i)' returning the template_argument of argument i
+		template<typename Get>
+		static bool match_arguments( const detail::pattern_layer& p , size_t num , Get&& get , captures& caps )
+		{
+			size_t fixed = p.arguments.size();
+			if( p.has_pack ? num < fixed : num != fixed )
+				return false;
+			for( size_t i = 0 ; i < fixed ; i++ )
+				if( !match_argument( p.arguments[i] , get( i ) , caps ) )
+					return false;
+			if( !p.has_pack )
+				return true;
+			template_argument_list rest;
+			for( size_t i = fixed ; i < num ; i++ )
+				rest.push_back( get( i ) );
+			return capture( caps , p.pack_name , std::move(rest) );
+		}
+		
+		//! Matches one layer. May leave captures behind, if it fails
+		static bool match_layer( const detail::pattern_layer& p , const type::layer& lr , captures& caps )
+		{
+			if( lr.layer_type != p.kind || lr.is_const != p.is_const || lr.is_volatile != p.is_volatile )
+				return false;
+			if( p.kind == layer_type::function )
+				return match_arguments( p , lr.arguments.size() , [&lr]( size_t i ){ return template_argument{ lr.arguments.begin()[i] , {} }; } , caps );
+			switch( p.how ){
+				case detail::pattern_layer::exact:
+					return lr.content == p.content;
+				case detail::pattern_layer::placeholder:
+					if( p.kind == layer_type::array ) // Extents are expressions
+						return capture( caps , p.content , { template_argument{ nullptr , lr.content } } );
+					return capture( caps , p.content , { template_argument{ std::make_shared<const type>( lr.content.view() ) , {} } } );
+				case detail::pattern_layer::template_id:
+				{
+					if( detail::template_name( lr.content.view() ) != p.content.view() )
+						return false;
+					const template_argument_list& arguments = lr.content.template_arguments();
+					return match_arguments( p , arguments.size() , [&arguments]( size_t i ) -> const template_argument& { return arguments[i]; } , caps );
+				}
+			}
+			return false;
+		}
+		
+		//! Matches 't' against a single compiled pattern. Restores 'caps', if it fails
+		static bool match_type( const detail::compiled_pattern& p , const type& t , captures& caps )
+		{
+			size_t num_layers = t.layers.size();
+			size_t num_pattern_layers = p.layers.size();
+			if( p.is_open ? num_layers <= num_pattern_layers : num_layers != num_pattern_layers )
+				return false;
+			size_t mark = caps.size();
+			for( size_t i = 0 ; i < num_pattern_layers ; i++ )
+				if( !match_layer( p.layers[i] , t.layers[num_layers - 1 - i] , caps ) ){
+					caps.resize( mark );
+					return false;
+				}
+			if( p.is_open && !capture_inner( caps , t , num_layers - num_pattern_layers , p.name , p.is_const , p.is_volatile ) ){
+				caps.resize( mark );
+				return false;
+			}
+			return true;
+		}
+		
+		//! Walks the decision tree from 'node', 'remaining' being the number of innermost layers of 't' not matched yet
+		template<typename Callback>
+		void walk( std::uint32_t node_index , const type& t , size_t remaining , captures& caps , Callback& callback ) const
+		{
+			const detail::pattern_node&	node = nodes[node_index];
+			size_t						mark = caps.size();
+			
+			if( remaining == 0 ){
+				for( std::uint32_t pattern : node.ends )
+					callback( size_t( pattern ) , static_cast<const captures&>( caps ) );
+				return;
+			}
+			
+			for( const detail::pattern_node::open_end& end : node.open_ends ){
+				if( capture_inner( caps , t , remaining , end.name , end.is_const , end.is_volatile ) )
+					callback( size_t( end.pattern ) , static_cast<const captures&>( caps ) );
+				caps.resize( mark );
+			}
+			
+			const type::layer& lr = t.layers[remaining - 1];
+			if( !node.exact.empty() ){
+				auto it = node.exact.find( detail::pattern_layer_key( lr.layer_type , lr.is_const , lr.is_volatile , lr.content ) );
+				if( it != node.exact.end() )
+					walk( it->second , t , remaining - 1 , caps , callback );
+			}
+			
+			auto try_edge = [&]( std::uint32_t edge ){
+				const auto& generic = node.generic[edge];
+				if( match_layer( generic.first , lr , caps ) )
+					walk( generic.second , t , remaining - 1 , caps , callback );
+				caps.resize( mark );
+			};
+			for( std::uint32_t edge : node.generic_other )
+				try_edge( edge );
+			if( !node.generic_by_name.empty() ){
+				std::string_view name = detail::template_name( lr.content.view() );
+				if( !name.empty() ){
+					auto it = node.generic_by_name.find( name );
+					if( it != node.generic_by_name.end() )
+						for( std::uint32_t edge : it->second )
+							try_edge( edge );
+				}
+			}
+		}
+		
+	public:
+		
+		pattern_set() = default;
+		pattern_set( std::initializer_list<std::string_view> patterns ){
+			for( std::string_view pattern : patterns )
+				add( pattern );
+		}
+		
+		/**
+		 * Compiles 'pattern' and adds it to the set. Returns its index, by which it is reported in matches.
+		 * Throws std::invalid_argument, if 'pattern' is no valid pattern.
+		 */
+		size_t add( std::string_view pattern )
+		{
+			std::string	renamed = rename_placeholders( pattern );
+			type		t( nullptr );
+			size_t		length = renamed.size();
+			while( length && detail::is_space( renamed[length - 1] ) )
+				length--;
+			if( !length || t.parse_prefix( renamed ) != length )
+				fail( pattern , "syntax error" );
+			
+			bool is_pack = false;
+			detail::compiled_pattern compiled = compile( t , pattern , &is_pack );
+			if( is_pack )
+				fail( pattern , "misplaced '...'" );
+			
+			sources.emplace_back( pattern );
+			insert( compiled , std::uint32_t( sources.size() - 1 ) );
+			return sources.size() - 1;
+		}
+		
+		//! Number of patterns in the set
+		size_t size() const { return sources.size(); }
+		bool empty() const { return sources.empty(); }
+		
+		//! Returns pattern 'index' as passed to add()
+		std::string_view pattern( size_t index ) const { return sources[index]; }
+		
+		/**
+		 * Matches 't' against all patterns at once and calls 'callback( size_t pattern , const std::vector<pattern_capture>& captures )'
+		 * for every matching pattern (in no particular order). Returns the number of matching patterns.
+		 */
+		template<typename Callback>
+		size_t match( const type& t , Callback&& callback ) const
+		{
+			size_t		num_matches = 0;
+			captures	caps;
+			auto		counting_callback = [&]( size_t pattern , const captures& result ){
+				num_matches++;
+				callback( pattern , result );
+			};
+			walk( 0 , t , t.layers.size() , caps , counting_callback );
+			return num_matches;
+		}
+		
+		//! Returns all patterns matching 't', ordered by their index
+		std::vector<pattern_match> match( const type& t ) const
+		{
+			std::vector<pattern_match> result;
+			match( t , [&result]( size_t pattern , const captures& caps ){ result.push_back( { pattern , caps } ); } );
+			std::sort( result.begin() , result.end() , []( const pattern_match& lhs , const pattern_match& rhs ){ return lhs.pattern < rhs.pattern; } );
+			return result;
+		}
+		
+		//! Checks, whether 't' matches any pattern
+		bool matches( const type& t ) const {
+			return match( t , []( size_t , const captures& ){} ) != 0;
+		}
+	};
+	
+} // namespace parser
+
+#endif
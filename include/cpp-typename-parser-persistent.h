@@ -0,0 +1,324 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_PERSISTENT_H_
+#define _CPP_TYPENAME_PARSER_PERSISTENT_H_
+
+#include "cpp-typename-parser.h"
+
+namespace parser
+{
+	/**
+	 * Immutable counterpart of 'type' for deriving many variants from few base types.
+	 * The layers form a linked list from the outermost to the innermost layer, that is shared between all types
+	 * derived from one another: Copies only copy a pointer, and every modifier returns a new type that allocates
+	 * at most one node on top of the (shared) rest (set_datatype() copies the layers above the basic data type).
+	 * Every node caches the hash of the layers up to it, so hash() takes constant time and equals type::hash().
+	 */
+	class persistent_type
+	{
+	public:
+	
+		using layer_type = parser::layer_type;
+		
+		struct layer
+		{
+			parser::layer_type				layer_type = parser::layer_type::type;
+			symbol							content; // Interned in the global symbol_table
+			bool							is_const = false;
+			bool							is_volatile = false;
+			std::vector<persistent_type>	arguments; // Parameters of a function layer
+			
+			layer(
+				parser::layer_type layer_type = parser::layer_type::type , symbol content = {}
+				, bool is_const = false , bool is_volatile = false , std::vector<persistent_type> arguments = {}
+			)
+				: layer_type( layer_type ) , content( content ) , is_const( is_const ) , is_volatile( is_volatile ) , arguments( std::move(arguments) )
+			{}
+		};
+	
+	private:
+	
+		struct node
+		{
+			layer						value;
+			std::shared_ptr<const node>	inner;
+			std::uint32_t				size; // Number of layers up to this one
+			size_t						hash; // Hash of the layers up to this one (as computed by type::hash(), but without reserving 0)
+		};
+		
+		std::shared_ptr<const node> head; // Outermost layer, null if there are no layers
+		
+		explicit persistent_type( std::shared_ptr<const node> head ) : head( std::move(head) ) {}
+		
+		//! Returns a new type with 'value' as outermost layer on top of 'inner'
+		static persistent_type push( const std::shared_ptr<const node>& inner , layer value ){
+			size_t hash = inner ? inner->hash : detail::hash_seed;
+			hash = detail::hash_combine( hash , size_t(value.layer_type) | size_t(value.is_const) << 3 | size_t(value.is_volatile) << 4 );
+			hash = detail::hash_combine( hash , value.content.id() );
+			for( const persistent_type& arg : value.arguments )
+				hash = detail::hash_combine( hash , arg.hash() );
+			std::uint32_t size = inner ? inner->size + 1 : 1;
+			return persistent_type( std::make_shared<const node>( node{ std::move(value) , inner , size , hash } ) );
+		}
+		
+		//! The (shared) node of a plain 'void'
+		static const std::shared_ptr<const node>& void_node(){
+			static const std::shared_ptr<const node> instance = push( nullptr , { layer_type::type , "void" } ).head;
+			return instance;
+		}
+		
+		//! The node of the outermost layer, or that of an implicit 'void' if there are no layers
+		const std::shared_ptr<const node>& non_empty_head() const { return head ? head : void_node(); }
+		
+		//! Returns this type with the cv-qualifiers of the outermost layer changed by 'modify'
+		template<typename Modify>
+		persistent_type modify_outermost( Modify&& modify ) const {
+			const std::shared_ptr<const node>& outer = non_empty_head();
+			layer value = outer->value;
+			modify( value );
+			return push( outer->inner , std::move(value) );
+		}
+		
+		//! Calls 'function' with the layers of this type from the innermost to the outermost one (as random access sequence)
+		template<typename Function>
+		void with_layers( Function&& function ) const
+		{
+			struct layer_sequence
+			{
+				const node* const*	nodes;
+				size_t				num_nodes;
+				
+				size_t size() const { return num_nodes; }
+				const layer& operator[]( size_t index ) const { return nodes[index]->value; }
+			};
+			
+			const node*					inline_nodes[16];
+			std::vector<const node*>	heap_nodes;
+			const node**				nodes = inline_nodes;
+			size_t						num_nodes = size();
+			if( num_nodes > std::size( inline_nodes ) ){
+				heap_nodes.resize( num_nodes );
+				nodes = heap_nodes.data();
+			}
+			size_t index = num_nodes;
+			for( const node* cur = head.get() ; cur ; cur = cur->inner.get() )
+				nodes[--index] = cur;
+			function( layer_sequence{ nodes , num_nodes } );
+		}
+	
+	public:
+	
+		//! Default Ctor ('void')
+		persistent_type() : head( void_node() ) {}
+		
+		//! Ctor with no layers at all
+		persistent_type( std::nullptr_t ) {}
+		
+		//! Ctor from C++ typename in string form
+		explicit persistent_type( const char* input ) : persistent_type( type( input ) ) {}
+		explicit persistent_type( std::string_view input ) : persistent_type( type( input ) ) {}
+		
+		//! Ctor from a 'type' (whose layers are copied once)
+		explicit persistent_type( const type& t ){
+			for( const auto& lr : t ){
+				layer value{ lr.layer_type , lr.content , lr.is_const , lr.is_volatile , {} };
+				value.arguments.reserve( lr.arguments.size() );
+				for( const auto& arg : lr.arguments )
+					value.arguments.emplace_back( *arg );
+				head = push( head , std::move(value) ).head;
+			}
+		}
+		
+		//! Copies this type into a (modifiable) 'type'
+		type to_type( type::allocator_type alloc = {} ) const {
+			type result( nullptr , alloc );
+			result.layers.reserve( size() );
+			with_layers( [&]( const auto& layers ){
+				for( size_t i = 0 ; i < layers.size() ; i++ ){
+					const layer& lr = layers[i];
+					result.layers.emplace_back( lr.layer_type , lr.content , lr.is_const , lr.is_volatile );
+					for( const persistent_type& arg : lr.arguments )
+						result.layers.back().arguments.push_back( std::allocate_shared<type>( alloc , arg.to_type( alloc ) ) );
+				}
+			});
+			return result;
+		}
+		
+		//! Comparison operator (constant time for types sharing their nodes or differing in their hashes)
+		bool operator==( const persistent_type& other ) const {
+			const node* lhs = head.get();
+			const node* rhs = other.head.get();
+			if( lhs == rhs )
+				return true;
+			if( !lhs || !rhs || lhs->size != rhs->size || lhs->hash != rhs->hash )
+				return false;
+			for( ; lhs != rhs ; lhs = lhs->inner.get() , rhs = rhs->inner.get() ){
+				const layer& l = lhs->value;
+				const layer& r = rhs->value;
+				if( l.layer_type != r.layer_type || l.is_const != r.is_const || l.is_volatile != r.is_volatile || l.content != r.content || l.arguments != r.arguments )
+					return false;
+			}
+			return true;
+		}
+		bool operator!=( const persistent_type& other ) const { return !( *this == other ); }
+		
+		//! Structural hash, equal to the hash of the corresponding 'type'
+		size_t hash() const {
+			size_t result = head ? head->hash : detail::hash_seed;
+			return result + !result;
+		}
+		
+		//! Boolean conversion
+		explicit operator bool() const { return head != nullptr; }
+		
+		//! Returns the number of layers
+		size_t size() const { return head ? head->size : 0; }
+		
+		//! Returns the outermost layer (the type must not be empty)
+		const layer& outermost() const { return head->value; }
+		
+		//! Returns this type without its outermost layer (the type must not be empty)
+		persistent_type inner() const { return persistent_type( head->inner ); }
+		
+		//! Convert this structure to a string representation (possibly to declare a variable 'name')
+		std::string to_string( std::string_view name = {} ) const {
+			std::string output;
+			to_string( output , name );
+			return output;
+		}
+		
+		//! Appends the string representation of this type (possibly declaring a variable 'name') to 'output'
+		void to_string( std::string& output , std::string_view name ) const {
+			with_layers( [&]( const auto& layers ){ detail::emitter::write( output , layers , name ); } );
+		}
+	
+	public: //! MODIFIERS (Returning the modified type) !//
+	
+		//! Returns this type with 't' as basic data type
+		persistent_type set_datatype( const persistent_type& t ) const {
+			std::vector<const node*> outer_nodes;
+			for( const node* cur = head.get() ; cur && !( cur->value.layer_type == layer_type::type && !cur->inner ) ; cur = cur->inner.get() )
+				outer_nodes.push_back( cur );
+			persistent_type result = t;
+			for( size_t i = outer_nodes.size() ; i-- > 0 ; )
+				result = push( result.head , outer_nodes[i]->value );
+			return result;
+		}
+		//! Returns this type with a 'const' qualification at the outermost level
+		persistent_type add_const() const {
+			switch( non_empty_head()->value.layer_type ){
+				case layer_type::type:
+				case layer_type::pointer:
+				case layer_type::member_pointer:
+					if( non_empty_head()->value.is_const )
+						return persistent_type( non_empty_head() );
+					return modify_outermost( []( layer& lr ){ lr.is_const = true; } );
+				default:
+					return persistent_type( non_empty_head() );
+			}
+		}
+		//! Returns this type with a 'volatile' qualification at the outermost level
+		persistent_type add_volatile() const {
+			switch( non_empty_head()->value.layer_type ){
+				case layer_type::type:
+				case layer_type::pointer:
+				case layer_type::member_pointer:
+					if( non_empty_head()->value.is_volatile )
+						return persistent_type( non_empty_head() );
+					return modify_outermost( []( layer& lr ){ lr.is_volatile = true; } );
+				default:
+					return persistent_type( non_empty_head() );
+			}
+		}
+		//! Returns a pointer to this type
+		persistent_type add_pointer() const { return push( non_empty_head() , { layer_type::pointer } ); }
+		//! Returns an lvalue reference to this type
+		persistent_type add_lvalue_reference() const { return push( non_empty_head() , { layer_type::lvalue } ); }
+		//! Returns an rvalue reference to this type
+		persistent_type add_rvalue_reference() const { return push( non_empty_head() , { layer_type::rvalue } ); }
+		//! Returns a pointer to a member of class 'class_name' with this type
+		persistent_type add_member_pointer( symbol class_name ) const { return push( non_empty_head() , { layer_type::member_pointer , class_name } ); }
+		//! Returns an array of this type
+		persistent_type add_array( int extent = -1 ) const {
+			return push( non_empty_head() , { layer_type::array , extent > 0 ? symbol( detail::to_string(extent) ) : symbol() } );
+		}
+		//! Returns a function returning this type
+		persistent_type add_function( std::vector<persistent_type> parameters = {} ) const {
+			return push( non_empty_head() , { layer_type::function , {} , false , false , std::move(parameters) } );
+		}
+		//! Returns this type without 'const' qualification at the outermost level
+		persistent_type remove_const() const {
+			if( !head || !head->value.is_const )
+				return *this;
+			return modify_outermost( []( layer& lr ){ lr.is_const = false; } );
+		}
+		//! Returns this type without 'volatile' qualification at the outermost level
+		persistent_type remove_volatile() const {
+			if( !head || !head->value.is_volatile )
+				return *this;
+			return modify_outermost( []( layer& lr ){ lr.is_volatile = false; } );
+		}
+		//! Returns this type without reference qualification at the outermost level
+		persistent_type remove_reference() const {
+			return is_lvalue_reference() || is_rvalue_reference() ? inner() : *this;
+		}
+		//! Returns this type without pointer, array or function qualification at the outermost level
+		persistent_type remove_pointer() const {
+			return is_pointer() || is_member_pointer() || is_array() || is_function() ? inner() : *this;
+		}
+	
+	public: //! INFORMATION RETRIEVAL !//
+	
+		std::string get_datatype() const {
+			const node* cur = head.get();
+			while( cur && cur->inner )
+				cur = cur->inner.get();
+			return cur && cur->value.layer_type == layer_type::type ? std::string( cur->value.content ) : std::string();
+		}
+		bool is_plain() const { return size() == 1 && head->value.layer_type == layer_type::type; }
+		bool is_lvalue_reference() const { return head && head->value.layer_type == layer_type::lvalue; }
+		bool is_rvalue_reference() const { return head && head->value.layer_type == layer_type::rvalue; }
+		bool is_array() const { return head && head->value.layer_type == layer_type::array; }
+		bool is_function() const { return head && head->value.layer_type == layer_type::function; }
+		bool is_pointer() const { return head && head->value.layer_type == layer_type::pointer; }
+		bool is_member_pointer() const { return head && head->value.layer_type == layer_type::member_pointer; }
+		bool is_const() const { return head && head->value.is_const; }
+		bool is_volatile() const { return head && head->value.is_volatile; }
+		bool is_void() const { return size() == 1 && head->value.content == "void"; }
+	};
+
+} // namespace parser
+
+namespace std
+{
+	template<>
+	struct hash<parser::persistent_type>
+	{
+		size_t operator()( const parser::persistent_type& t ) const { return t.hash(); }
+	};
+}
+
+#endif
@@ -0,0 +1,225 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_STREAM_H_
+#define _CPP_TYPENAME_PARSER_STREAM_H_
+
+#include "cpp-typename-parser-batch.h" // For batch_entry
+#include "cpp-typename-parser-find.h" // For find_types
+#include <functional>
+
+namespace parser
+{
+	//! Default limit of the length of one entry (or line) of a stream, beyond which it is not buffered
+	constexpr size_t default_max_entry_size = size_t(1) << 20;
+	
+	/**
+	 * Push parser for a stream of newline- or NUL-separated type names (as read by parse_batch()),
+	 * that arrives in chunks of arbitrary size. Every entry is passed to the callback as soon as
+	 * its separator was fed. Entries lying within one chunk are parsed in place, only the unfinished
+	 * entry at the end of a chunk is kept until it is complete. No byte is scanned twice.
+	 * Entries longer than 'max_entry_size' are not kept, but passed to the callback as failed entries.
+	 */
+	class stream_parser
+	{
+	public:
+		
+		using callback_type = std::function<void( batch_entry&& entry )>;
+		
+	private:
+		
+		callback_type	callback;
+		size_t			max_entry_size;
+		std::string		pending; // Beginning of the unfinished entry
+		bool			overflowed = false; // Whether the unfinished entry exceeds 'max_entry_size'
+		size_t			num_overflows = 0;
+		
+		void emit( std::string_view name ){
+			batch_entry entry;
+			entry.success = entry.value.parse( name );
+			callback( std::move(entry) );
+		}
+		void emit_overflow(){
+			num_overflows++;
+			callback( batch_entry() );
+		}
+		
+	public:
+		
+		explicit stream_parser( callback_type callback , size_t max_entry_size = default_max_entry_size )
+			: callback( std::move(callback) ) , max_entry_size( max_entry_size )
+		{}
+		
+		//! Parses all entries completed by 'chunk'. Returns the number of entries passed to the callback
+		size_t feed( std::string_view chunk )
+		{
+			const char*	begin = chunk.data();
+			const char*	end = begin + chunk.size();
+			size_t		num_entries = 0;
+			
+			for( const char* pos = begin ; pos != end ; pos++ ){
+				if( *pos != '\n' && *pos != '\0' )
+					continue;
+				if( overflowed || pending.size() + ( pos - begin ) > max_entry_size )
+					emit_overflow();
+				else if( pending.empty() )
+					emit( std::string_view( begin , pos - begin ) );
+				else{
+					pending.append( begin , pos );
+					emit( pending );
+				}
+				pending.clear();
+				overflowed = false;
+				begin = pos + 1;
+				num_entries++;
+			}
+			if( overflowed || pending.size() + ( end - begin ) > max_entry_size ){
+				std::string().swap( pending ); // Release the memory
+				overflowed = true;
+			}
+			else
+				pending.append( begin , end );
+			return num_entries;
+		}
+		
+		//! Ends the stream and passes the last entry, if it was not terminated by a separator. Returns the number of entries passed to the callback
+		size_t finish()
+		{
+			if( overflowed )
+				emit_overflow();
+			else if( !pending.empty() )
+				emit( pending );
+			else
+				return 0;
+			pending.clear();
+			overflowed = false;
+			return 1;
+		}
+		
+		//! Returns the number of bytes of the unfinished entry, that are kept until it is complete
+		size_t pending_size() const { return pending.size(); }
+		
+		//! Returns the number of entries, that were longer than 'max_entry_size' and passed to the callback as failed entries
+		size_t overflow_count() const { return num_overflows; }
+	};
+	
+	/**
+	 * Push variant of find_types() for free-form text (e.g. a build log, as it is written), that arrives in chunks of
+	 * arbitrary size. Since type names never span multiple lines, find_types() is run over all lines completed by a chunk
+	 * at once, only the unfinished line at the end of a chunk is kept until it is complete. The offsets of the names
+	 * passed to the callback are relative to the beginning of the stream.
+	 * Unfinished lines are only kept up to 'max_line_size' bytes: longer lines, that do not lie within one chunk,
+	 * are skipped without being searched.
+	 */
+	class stream_finder
+	{
+	public:
+		
+		using callback_type = std::function<void( found_type&& found )>;
+		
+	private:
+		
+		callback_type	callback;
+		size_t			max_line_size;
+		std::string		pending; // Beginning of the unfinished line
+		size_t			pending_offset = 0; // Position of the unfinished line within the stream
+		size_t			num_bytes = 0; // Number of bytes fed so far
+		bool			overflowed = false; // Whether the unfinished line exceeds 'max_line_size'
+		size_t			num_overflows = 0;
+		
+		size_t search( std::string_view lines , size_t offset ){
+			return find_types( lines , [this,offset]( found_type&& found ){
+				found.offset += offset;
+				callback( std::move(found) );
+			} );
+		}
+		
+	public:
+		
+		explicit stream_finder( callback_type callback , size_t max_line_size = default_max_entry_size )
+			: callback( std::move(callback) ) , max_line_size( max_line_size )
+		{}
+		
+		//! Searches all lines completed by 'chunk'. Returns the number of names passed to the callback
+		size_t feed( std::string_view chunk )
+		{
+			size_t	chunk_offset = num_bytes;
+			size_t	num_found = 0;
+			num_bytes += chunk.size();
+			size_t	first_line_end = chunk.find( '\n' );
+			
+			if( first_line_end != std::string_view::npos ){
+				size_t last_line_end = chunk.rfind( '\n' );
+				
+				// Complete the unfinished line first
+				if( overflowed || pending.size() + first_line_end > max_line_size ){
+					num_overflows++;
+					first_line_end++;
+				}
+				else if( pending.empty() )
+					first_line_end = 0; // Searched together with the following lines
+				else{
+					pending.append( chunk.data() , first_line_end );
+					num_found += search( pending , pending_offset );
+					first_line_end++;
+				}
+				num_found += search( chunk.substr( first_line_end , last_line_end + 1 - first_line_end ) , chunk_offset + first_line_end );
+				
+				pending.clear();
+				overflowed = false;
+				pending_offset = chunk_offset + last_line_end + 1;
+				chunk.remove_prefix( last_line_end + 1 );
+			}
+			
+			if( overflowed || pending.size() + chunk.size() > max_line_size ){
+				std::string().swap( pending ); // Release the memory
+				overflowed = true;
+			}
+			else
+				pending.append( chunk.data() , chunk.size() );
+			return num_found;
+		}
+		
+		//! Ends the stream and searches the last line, if it was not terminated by a newline. Returns the number of names passed to the callback
+		size_t finish()
+		{
+			size_t num_found = overflowed ? 0 : search( pending , pending_offset );
+			num_overflows += overflowed;
+			pending_offset = num_bytes;
+			pending.clear();
+			overflowed = false;
+			return num_found;
+		}
+		
+		//! Returns the number of bytes of the unfinished line, that are kept until it is complete
+		size_t pending_size() const { return pending.size(); }
+		
+		//! Returns the number of lines, that were skipped for being longer than 'max_line_size'
+		size_t overflow_count() const { return num_overflows; }
+	};
+	
+} // namespace parser
+
+#endif
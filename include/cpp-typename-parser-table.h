@@ -0,0 +1,341 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_TABLE_H_
+#define _CPP_TYPENAME_PARSER_TABLE_H_
+
+#include "cpp-typename-parser.h"
+#include <bitset>
+
+namespace parser
+{
+	namespace detail
+	{
+		//! Sets bit i of 'dest' (i < 'size'), if column[i] equals 'value'. 'dest' must hold (size+63)/64 words
+		inline void match_column( const unsigned char* column , size_t size , unsigned char value , std::uint64_t* dest )
+		{
+			size_t i = 0;
+			#if CPP_TYPENAME_PARSER_SSE2
+			const __m128i wanted = _mm_set1_epi8( char( value ) );
+			for( ; size - i >= 64 ; i += 64 ){
+				std::uint64_t mask = 0;
+				for( int j = 0 ; j < 64 ; j += 16 ){
+					__m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>( column + i + j ) );
+					mask |= std::uint64_t( unsigned( _mm_movemask_epi8( _mm_cmpeq_epi8( chunk , wanted ) ) ) ) << j;
+				}
+				dest[i / 64] = mask;
+			}
+			#endif
+			for( ; i < size ; i += 64 ){
+				std::uint64_t mask = 0;
+				for( size_t j = 0 ; j < 64 && i + j < size ; j++ )
+					mask |= std::uint64_t( column[i + j] == value ) << j;
+				dest[i / 64] = mask;
+			}
+		}
+		
+		//! Sets bit i of 'dest' (i < 'size'), if column[i] equals 'value'. 'dest' must hold (size+63)/64 words
+		inline void match_column( const std::uint32_t* column , size_t size , std::uint32_t value , std::uint64_t* dest )
+		{
+			size_t i = 0;
+			#if CPP_TYPENAME_PARSER_SSE2
+			const __m128i wanted = _mm_set1_epi32( int( value ) );
+			for( ; size - i >= 64 ; i += 64 ){
+				std::uint64_t mask = 0;
+				for( int j = 0 ; j < 64 ; j += 4 ){
+					__m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>( column + i + j ) );
+					mask |= std::uint64_t( unsigned( _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( chunk , wanted ) ) ) ) ) << j;
+				}
+				dest[i / 64] = mask;
+			}
+			#endif
+			for( ; i < size ; i += 64 ){
+				std::uint64_t mask = 0;
+				for( size_t j = 0 ; j < 64 && i + j < size ; j++ )
+					mask |= std::uint64_t( column[i + j] == value ) << j;
+				dest[i / 64] = mask;
+			}
+		}
+	}
+	
+	/**
+	 * Set of row indices of a type_table, one bit per row (as returned by the bulk predicates of type_table).
+	 */
+	class type_bitmap
+	{
+	private:
+		
+		std::vector<std::uint64_t>	words;
+		size_t						size_ = 0;
+		
+		//! Clears the bits past 'size_' in the last word
+		void trim(){
+			if( size_ % 64 )
+				words.back() &= ~std::uint64_t(0) >> ( 64 - size_ % 64 );
+		}
+		
+		friend class type_table;
+		
+	public:
+		
+		type_bitmap() = default;
+		explicit type_bitmap( size_t size , bool value = false ) : words( ( size + 63 ) / 64 , value ? ~std::uint64_t(0) : 0 ) , size_( size ) { trim(); }
+		
+		//! Number of rows, that this bitmap refers to
+		size_t size() const { return size_; }
+		
+		bool test( size_t i ) const { return words[i / 64] >> ( i % 64 ) & 1; }
+		bool operator[]( size_t i ) const { return test( i ); }
+		void set( size_t i , bool value = true ){
+			if( value )
+				words[i / 64] |= std::uint64_t(1) << ( i % 64 );
+			else
+				words[i / 64] &= ~( std::uint64_t(1) << ( i % 64 ) );
+		}
+		
+		//! Returns the number of set bits
+		size_t count() const {
+			size_t result = 0;
+			for( std::uint64_t word : words )
+				result += std::bitset<64>( word ).count();
+			return result;
+		}
+		bool any() const { return std::any_of( words.begin() , words.end() , []( std::uint64_t word ){ return word != 0; } ); }
+		bool none() const { return !any(); }
+		
+		//! Calls 'callback(i)' for every set bit i in ascending order
+		template<typename Callback>
+		void for_each( Callback&& callback ) const {
+			for( size_t w = 0 ; w < words.size() ; w++ )
+				for( std::uint64_t word = words[w] ; word ; word &= word - 1 )
+					callback( w * 64 + detail::scan::count_trailing_zeros( word ) );
+		}
+		
+		//! Returns the indices of all set bits in ascending order
+		std::vector<size_t> indices() const {
+			std::vector<size_t> result;
+			result.reserve( count() );
+			for_each( [&result]( size_t i ){ result.push_back( i ); } );
+			return result;
+		}
+		
+		//! Set operations (both bitmaps must refer to the same rows)
+		type_bitmap& operator&=( const type_bitmap& other ){
+			for( size_t i = 0 ; i < words.size() ; i++ )
+				words[i] &= other.words[i];
+			return *this;
+		}
+		type_bitmap& operator|=( const type_bitmap& other ){
+			for( size_t i = 0 ; i < words.size() ; i++ )
+				words[i] |= other.words[i];
+			return *this;
+		}
+		type_bitmap operator&( const type_bitmap& other ) const { type_bitmap result = *this; return result &= other; }
+		type_bitmap operator|( const type_bitmap& other ) const { type_bitmap result = *this; return result |= other; }
+		type_bitmap operator~() const {
+			type_bitmap result = *this;
+			for( std::uint64_t& word : result.words )
+				word = ~word;
+			result.trim();
+			return result;
+		}
+		
+		bool operator==( const type_bitmap& other ) const { return size_ == other.size_ && words == other.words; }
+		bool operator!=( const type_bitmap& other ) const { return !( *this == other ); }
+	};
+	
+	/**
+	 * Container of many types in columnar form (structure of arrays), meant for scanning large sets of types.
+	 * Layers of all types are stored back to back (innermost to outermost) in one column per field:
+	 * Their kinds as bytes, their cv-qualifiers as bitsets and their contents as ids of the global symbol_table.
+	 * Per type, the offset of its first layer and copies of the fields that the bulk predicates look at
+	 * (kind and cv-qualifiers of the outermost layer and the basic data type) are kept in columns of their own.
+	 * Function parameters are stored as rows of a nested table.
+	 */
+	class type_table
+	{
+	private:
+		
+		// Per layer
+		std::vector<layer_type>		layer_kinds;
+		std::vector<symbol>			layer_contents;
+		std::vector<std::uint64_t>	layer_const_bits;
+		std::vector<std::uint64_t>	layer_volatile_bits;
+		
+		// Per function layer: The index of the layer and the rows of its parameters within 'parameters'
+		std::vector<std::uint32_t>	function_layers;
+		std::vector<std::uint32_t>	argument_offsets{ 0 };
+		std::vector<std::uint32_t>	arguments;
+		std::unique_ptr<type_table>	parameters;
+		
+		// Per type
+		std::vector<std::uint32_t>	layer_offsets{ 0 };
+		std::vector<layer_type>		outermost_kinds;
+		type_bitmap					outermost_const;
+		type_bitmap					outermost_volatile;
+		std::vector<std::uint32_t>	datatypes; // Content of the innermost layer, if it is of kind 'type'
+		
+		static void push_bit( std::vector<std::uint64_t>& bits , size_t index , bool value ){
+			if( index % 64 == 0 )
+				bits.push_back( 0 );
+			bits.back() |= std::uint64_t( value ) << ( index % 64 );
+		}
+		static void push_bit( type_bitmap& bitmap , bool value ){
+			push_bit( bitmap.words , bitmap.size_++ , value );
+		}
+		static bool test_bit( const std::vector<std::uint64_t>& bits , size_t index ){
+			return bits[index / 64] >> ( index % 64 ) & 1;
+		}
+		
+	public:
+		
+		type_table() = default;
+		type_table( type_table&& ) = default;
+		type_table& operator=( type_table&& ) = default;
+		type_table( const type_table& other ) { *this = other; }
+		type_table& operator=( const type_table& other ){
+			if( this == &other )
+				return *this;
+			layer_kinds = other.layer_kinds;
+			layer_contents = other.layer_contents;
+			layer_const_bits = other.layer_const_bits;
+			layer_volatile_bits = other.layer_volatile_bits;
+			function_layers = other.function_layers;
+			argument_offsets = other.argument_offsets;
+			arguments = other.arguments;
+			parameters = other.parameters ? std::make_unique<type_table>( *other.parameters ) : nullptr;
+			layer_offsets = other.layer_offsets;
+			outermost_kinds = other.outermost_kinds;
+			outermost_const = other.outermost_const;
+			outermost_volatile = other.outermost_volatile;
+			datatypes = other.datatypes;
+			return *this;
+		}
+		
+		//! Number of types in the table
+		size_t size() const { return outermost_kinds.size(); }
+		bool empty() const { return outermost_kinds.empty(); }
+		
+		//! Number of layers of all types in the table (not counting function parameters)
+		size_t num_layers() const { return layer_kinds.size(); }
+		
+		//! Reserves space for 'num_types' types with 'num_layers' layers in total
+		void reserve( size_t num_types , size_t num_layers ){
+			layer_kinds.reserve( num_layers );
+			layer_contents.reserve( num_layers );
+			layer_const_bits.reserve( ( num_layers + 63 ) / 64 );
+			layer_volatile_bits.reserve( ( num_layers + 63 ) / 64 );
+			layer_offsets.reserve( num_types + 1 );
+			outermost_kinds.reserve( num_types );
+			outermost_const.words.reserve( ( num_types + 63 ) / 64 );
+			outermost_volatile.words.reserve( ( num_types + 63 ) / 64 );
+			datatypes.reserve( num_types );
+		}
+		
+		void clear(){ *this = type_table(); }
+		
+		//! Appends 't' as the last row. Returns the index of the row
+		size_t push_back( const type& t )
+		{
+			for( const auto& lr : t ){
+				if( lr.layer_type == layer_type::function ){
+					if( !parameters )
+						parameters = std::make_unique<type_table>();
+					function_layers.push_back( std::uint32_t( layer_kinds.size() ) );
+					for( const auto& arg : lr.arguments )
+						arguments.push_back( std::uint32_t( parameters->push_back( *arg ) ) );
+					argument_offsets.push_back( std::uint32_t( arguments.size() ) );
+				}
+				push_bit( layer_const_bits , layer_kinds.size() , lr.is_const );
+				push_bit( layer_volatile_bits , layer_kinds.size() , lr.is_volatile );
+				layer_kinds.push_back( lr.layer_type );
+				layer_contents.push_back( lr.content );
+			}
+			layer_offsets.push_back( std::uint32_t( layer_kinds.size() ) );
+			
+			bool has_layers = t.begin() != t.end();
+			outermost_kinds.push_back( has_layers ? t.end()[-1].layer_type : layer_type::type );
+			push_bit( outermost_const , has_layers && t.end()[-1].is_const );
+			push_bit( outermost_volatile , has_layers && t.end()[-1].is_volatile );
+			datatypes.push_back( has_layers && t.begin()->layer_type == layer_type::type ? t.begin()->content.id() : symbol_table::empty_id );
+			return size() - 1;
+		}
+		
+		//! Parses 'name' and appends it as the last row. Returns the index of the row
+		size_t push_back( std::string_view name ){ return push_back( type( name ) ); }
+		
+		//! Number of layers of the type in row 'i'
+		size_t num_layers( size_t i ) const { return layer_offsets[i + 1] - layer_offsets[i]; }
+		
+		//! Copies the type in row 'i' into a 'type'
+		type to_type( size_t i , type::allocator_type alloc = {} ) const
+		{
+			type result( nullptr , alloc );
+			result.layers.reserve( num_layers( i ) );
+			auto function = std::lower_bound( function_layers.begin() , function_layers.end() , layer_offsets[i] );
+			for( std::uint32_t l = layer_offsets[i] ; l < layer_offsets[i + 1] ; l++ ){
+				result.layers.emplace_back( layer_kinds[l] , layer_contents[l] , test_bit( layer_const_bits , l ) , test_bit( layer_volatile_bits , l ) );
+				if( layer_kinds[l] == layer_type::function ){
+					size_t f = function - function_layers.begin();
+					for( std::uint32_t a = argument_offsets[f] ; a < argument_offsets[f + 1] ; a++ )
+						result.layers.back().arguments.push_back( std::allocate_shared<type>( alloc , parameters->to_type( arguments[a] , alloc ) ) );
+					++function;
+				}
+			}
+			return result;
+		}
+		type operator[]( size_t i ) const { return to_type( i ); }
+		
+		//! Returns the string representation of the type in row 'i'
+		std::string to_string( size_t i ) const { return to_type( i ).to_string(); }
+		
+	public: //! BULK PREDICATES (Returning one bit per row) !//
+		
+		type_bitmap outermost_is( layer_type kind ) const {
+			type_bitmap result( size() );
+			detail::match_column( reinterpret_cast<const unsigned char*>( outermost_kinds.data() ) , size() , static_cast<unsigned char>( kind ) , result.words.data() );
+			return result;
+		}
+		type_bitmap is_plain() const { return outermost_is( layer_type::type ); }
+		type_bitmap is_lvalue_reference() const { return outermost_is( layer_type::lvalue ); }
+		type_bitmap is_rvalue_reference() const { return outermost_is( layer_type::rvalue ); }
+		type_bitmap is_array() const { return outermost_is( layer_type::array ); }
+		type_bitmap is_function() const { return outermost_is( layer_type::function ); }
+		type_bitmap is_pointer() const { return outermost_is( layer_type::pointer ); }
+		type_bitmap is_member_pointer() const { return outermost_is( layer_type::member_pointer ); }
+		type_bitmap is_const() const { return outermost_const; }
+		type_bitmap is_volatile() const { return outermost_volatile; }
+		
+		//! Rows, whose basic data type is 'datatype' (e.g. "std::string" for "const std::string*")
+		type_bitmap has_datatype( symbol datatype ) const {
+			type_bitmap result( size() );
+			detail::match_column( datatypes.data() , size() , datatype.id() , result.words.data() );
+			return result;
+		}
+	};
+	
+} // namespace parser
+
+#endif
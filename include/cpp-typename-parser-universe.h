@@ -0,0 +1,205 @@
+// Copyright (c) 2018 Jakob Riedle (DuffsDevice)
+// All rights reserved. Source: github.com/DuffsDevice/cpp-typename-parser
+
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR 'AS IS' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef _CPP_TYPENAME_PARSER_UNIVERSE_H_
+#define _CPP_TYPENAME_PARSER_UNIVERSE_H_
+
+#include "cpp-typename-parser.h"
+
+namespace parser
+{
+	class type_universe;
+	
+	/**
+	 * Handle to a type interned in a type_universe. Since every structurally distinct type exists only once
+	 * within a universe, two handles (of the same universe) are equal, if and only if they point to the same type.
+	 */
+	class interned_type
+	{
+	private:
+		
+		const type* ptr = nullptr;
+		
+		explicit interned_type( const type* ptr ) : ptr( ptr ) {}
+		
+		friend class type_universe;
+		
+	public:
+		
+		//! Null handle, that refers to no type
+		interned_type() = default;
+		
+		const type& operator*() const { return *ptr; }
+		const type* operator->() const { return ptr; }
+		const type* get() const { return ptr; }
+		explicit operator bool() const { return ptr != nullptr; }
+		
+		//! Comparison operators (Pointer comparisons)
+		bool operator==( const interned_type& other ) const { return ptr == other.ptr; }
+		bool operator!=( const interned_type& other ) const { return ptr != other.ptr; }
+		
+		//! Convert the type to a string representation (possibly to declare a variable 'name')
+		std::string to_string( std::string_view name = {} ) const { return ptr->to_string( name ); }
+	};
+	
+	/**
+	 * Hash-consing factory of types: intern() returns the one instance of every structurally distinct type.
+	 * Function parameters of interned types are themselves interned, so a parameter type such as 'int' is stored once,
+	 * no matter in how many signatures it appears. Memory thus grows with the number of distinct types, not their occurrences.
+	 * Interned types live as long as their universe and must not be modified. Copies of them share the interned parameters,
+	 * so they must not outlive the universe either. intern() may be called from multiple threads.
+	 */
+	class type_universe
+	{
+	private:
+		
+		struct shard
+		{
+			std::shared_mutex									mutex;
+			std::unordered_multimap<size_t, const type*>		types; // Structural hash -> type
+			std::pmr::monotonic_buffer_resource					storage; // Types, their layers and argument lists
+		};
+		
+		static constexpr size_t	num_shards = 16;
+		
+		shard					shards[num_shards];
+		std::atomic<size_t>		num_types{ 0 };
+		
+		//! Wraps an interned parameter without reference counting (the universe owns it)
+		static std::shared_ptr<type> share( const type* t ){
+			return std::shared_ptr<type>( std::shared_ptr<type>() , const_cast<type*>( t ) );
+		}
+		
+		//! Checks, whether the interned type 'lhs' equals 't', whose parameters (in order of appearance) are interned as 'arguments'
+		static bool equal( const type& lhs , const type& t , const type* const* arguments ){
+			return std::equal(
+				lhs.begin() , lhs.end() , t.begin() , t.end()
+				, [&arguments]( const type::layer& l , const type::layer& r ){
+					if( l.layer_type != r.layer_type || l.is_const != r.is_const || l.is_volatile != r.is_volatile || l.content != r.content || l.arguments.size() != r.arguments.size() )
+						return false;
+					for( const auto& arg : l.arguments )
+						if( arg.get() != *arguments++ )
+							return false;
+					return true;
+				}
+			);
+		}
+		
+		//! Returns the interned instance of 't', whose parameters are interned as 'arguments' already
+		interned_type insert( const type& t , const type* const* arguments )
+		{
+			size_t	hash = t.hash(); // Equal to the hash of the interned instance, since hashes are structural
+			shard&	sh = shards[( hash >> 4 ) % num_shards];
+			
+			{
+				std::shared_lock<std::shared_mutex> lock( sh.mutex );
+				auto range = sh.types.equal_range( hash );
+				for( auto it = range.first ; it != range.second ; ++it )
+					if( equal( *it->second , t , arguments ) )
+						return interned_type( it->second );
+			}
+			
+			std::unique_lock<std::shared_mutex> lock( sh.mutex );
+			auto range = sh.types.equal_range( hash ); // Another thread might have inserted it in the meantime
+			for( auto it = range.first ; it != range.second ; ++it )
+				if( equal( *it->second , t , arguments ) )
+					return interned_type( it->second );
+			
+			// Copy 't' into the storage of the shard, referring to the interned parameters
+			type* result = new( sh.storage.allocate( sizeof(type) , alignof(type) ) ) type( nullptr , type::allocator_type( &sh.storage ) );
+			result->layers.reserve( t.layers.size() );
+			for( const type::layer& lr : t ){
+				result->layers.emplace_back( lr.layer_type , lr.content , lr.is_const , lr.is_volatile );
+				if( lr.layer_type != layer_type::function )
+					continue;
+				result->layers.back().arguments.reserve( lr.arguments.size() );
+				for( size_t i = 0 ; i < lr.arguments.size() ; i++ )
+					result->layers.back().arguments.push_back( share( *arguments++ ) );
+			}
+			result->hash(); // Cache the hash before other threads can read it
+			sh.types.emplace( hash , result );
+			num_types.fetch_add( 1 , std::memory_order_relaxed );
+			return interned_type( result );
+		}
+		
+	public:
+		
+		type_universe() = default;
+		type_universe( const type_universe& ) = delete;
+		type_universe& operator=( const type_universe& ) = delete;
+		~type_universe(){
+			for( shard& sh : shards )
+				for( auto& entry : sh.types )
+					const_cast<type*>( entry.second )->~type();
+		}
+		
+		//! Returns the process-wide universe
+		static type_universe& global(){
+			static type_universe instance;
+			return instance;
+		}
+		
+		//! Returns the interned instance of 't'
+		interned_type intern( const type& t )
+		{
+			// Intern the parameters first, so they can be compared by address
+			size_t num_arguments = 0;
+			for( const type::layer& lr : t )
+				num_arguments += lr.arguments.size();
+			
+			const type*					local_arguments[8];
+			std::vector<const type*>	heap_arguments( num_arguments > 8 ? num_arguments : 0 );
+			const type**				arguments = num_arguments > 8 ? heap_arguments.data() : local_arguments;
+			const type**				next = arguments;
+			for( const type::layer& lr : t )
+				for( const auto& arg : lr.arguments )
+					*next++ = intern( *arg ).get();
+			return insert( t , arguments );
+		}
+		
+		//! Parses 'name' and returns the interned instance of the type
+		interned_type intern( std::string_view name ){ return intern( type( name ) ); }
+		interned_type intern( const char* name ){ return intern( type( name ) ); }
+		
+		//! Number of distinct types interned so far (including parameters)
+		size_t size() const { return num_types.load( std::memory_order_relaxed ); }
+	};
+	
+	//! Returns the instance of 't' within the process-wide type_universe
+	inline interned_type intern( const type& t ){ return type_universe::global().intern( t ); }
+	inline interned_type intern( std::string_view name ){ return type_universe::global().intern( name ); }
+	inline interned_type intern( const char* name ){ return type_universe::global().intern( name ); }
+	
+} // namespace parser
+
+namespace std
+{
+	template<>
+	struct hash<parser::interned_type>{
+		size_t operator()( const parser::interned_type& t ) const { return std::hash<const parser::type*>()( t.get() ); }
+	};
+}
+
+#endif
@@ -26,9 +26,40 @@
 #ifndef _CPP_TYPENAME_PARSER_H_
 #define _CPP_TYPENAME_PARSER_H_
 
+#include <string>
+#include <string_view>
 #include <vector>
+#include <algorithm> // For std::reverse and std::rotate
 #include <cstring>
+#include <cctype> // For std::isalnum
+#include <type_traits>
 #include <memory> // For std::shared_ptr and std::unique_ptr
+#include <memory_resource> // For type_arena
+#include <cstddef> // For std::byte
+#include <cstdint>
+#include <stdexcept> // For static_type and symbol_table
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map> // For symbol_table
+#include <deque>
+#include <iterator> // For std::size
+#include <utility> // For std::exchange
+
+// For detail::find_bracket, detail::skip_identifier and detail::identifier_mask64 (define CPP_TYPENAME_PARSER_NO_SIMD to use the scalar versions only)
+#if !defined(CPP_TYPENAME_PARSER_NO_SIMD) && ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) )
+#define CPP_TYPENAME_PARSER_SSE2 1
+#include <emmintrin.h>
+#if ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || defined(__i386__) )
+#define CPP_TYPENAME_PARSER_AVX2 1 // Selected at runtime
+#include <immintrin.h>
+#endif
+#endif
+
+// Set to 1 in order to maintain parse_stats (see thread_parse_stats() and set_parse_stats_callback())
+#ifndef CPP_TYPENAME_PARSER_STATS
+#define CPP_TYPENAME_PARSER_STATS 0
+#endif
 
 // For detail::demangle
 #if defined(__GNUG__) && !defined(__clang__)
@@ -75,669 +106,3702 @@ namespace parser
 		static inline std::string demangle(const char* name){ return name; } // Do nothing if not g++
 		#endif
 
+		//! Returns the signature of this function, which contains the name of 'T'
+		template<class T>
+		constexpr std::string_view function_signature(){
+			#if defined(_MSC_VER) && !defined(__clang__)
+			return __FUNCSIG__;
+			#else
+			return __PRETTY_FUNCTION__;
+			#endif
+		}
+		
+		// Position of the name of 'T' within function_signature<T>(), determined using a known type
+		constexpr size_t type_name_prefix = function_signature<double>().rfind( "double" );
+		constexpr size_t type_name_suffix = function_signature<double>().size() - type_name_prefix - 6;
+		
+		#if defined(_MSC_VER) && !defined(__clang__)
+		//! Removes the 'class', 'struct', 'enum' and 'union' keywords, that MSVC puts in front of class names
+		inline std::string remove_elaborated_type_specifiers( std::string_view name ){
+			std::string result;
+			for( size_t i = 0 ; i < name.size() ; ){
+				bool at_word_start = i == 0 || !( std::isalnum( (unsigned char)name[i-1] ) || name[i-1] == '_' );
+				size_t skip = 0;
+				for( std::string_view keyword : { "class " , "struct " , "enum " , "union " } )
+					if( at_word_start && name.substr( i , keyword.size() ) == keyword )
+						skip = keyword.size();
+				if( skip )
+					i += skip;
+				else
+					result += name[i++];
+			}
+			return result;
+		}
+		#endif
+		
+		//! Returns the name of 'T' without the need for RTTI (computed at compile time, except for MSVC)
 		template<class T>
-		std::string get_typename() {
-			return demangle( typeid(T).name() );
+		std::string_view get_typename(){
+			constexpr std::string_view signature = function_signature<T>();
+			constexpr std::string_view name = signature.substr( type_name_prefix , signature.size() - type_name_prefix - type_name_suffix );
+			#if defined(_MSC_VER) && !defined(__clang__)
+			static const std::string result = remove_elaborated_type_specifiers( name );
+			return result;
+			#else
+			return name;
+			#endif
 		}
 		
 		struct variadic_comma_type{ template <typename... T1> variadic_comma_type(T1&&...){} };
+		
+		//! Number of bits required to represent 'value'
+		inline size_t bit_width( std::uint64_t value ){
+			#if defined(__GNUC__)
+			return value ? 64 - __builtin_clzll( value ) : 0;
+			#else
+			size_t result = 0;
+			for( ; value ; value >>= 1 )
+				result++;
+			return result;
+			#endif
+		}
+		
+		constexpr size_t hash_seed = size_t( 0xcbf29ce484222325ull );
+		
+		//! Mixes 'value' into the hash 'seed'
+		constexpr size_t hash_combine( size_t seed , size_t value ){
+			return seed ^ ( value + size_t( 0x9e3779b97f4a7c15ull ) + ( seed << 6 ) + ( seed >> 2 ) );
+		}
+		
+		//! Per-thread buffer to assemble identifiers in before they are interned
+		inline std::string& scratch_buffer(){
+			static thread_local std::string buffer;
+			return buffer;
+		}
 	}
 	
 	/**
-	 * Use this class to parse (using parser::type("const int (*)[4]") )
-	 * or to generate (using myType.to_string()) C++ typenames
+	 * Counters describing the work done by the parser, e.g. to find the inputs that are slow to parse.
+	 * They are only maintained if CPP_TYPENAME_PARSER_STATS is set to 1, otherwise all counts stay zero
+	 * and the instrumentation does not cost anything.
 	 */
-	class type
+	struct parse_stats
 	{
-	private:
-		
-		enum class layer_type
-		{
-			type // <node_type>
-			, pointer // <node_ptr_or_ref>.1
-			, lvalue // <node_ptr_or_ref>.2
-			, rvalue // <node_ptr_or_ref>.3
-			, member_pointer // <node_mem_ptr>
-			, function // <node_array_func>.1
-			, array // <node_array_func>.2
-		};
-
-		struct layer
-		{
-			layer_type							layer_type;
-			std::string							content;
-			bool 								is_const;
-			bool 								is_volatile;
-			std::vector<std::shared_ptr<type>>	arguments;
-			
-			bool operator==( const layer& other ) const {
-				return
-					layer_type == other.layer_type
-					&& is_const == other.is_const
-					&& is_volatile == other.is_volatile
-					&& content == other.content
-					&& arguments == other.arguments
-				;
-			}
-			bool operator!=( const layer& other ) const { return *this == other; }
-		};
-		
-		std::vector<layer> layers;
-		
-	public:
+		size_t	parses = 0;
+		size_t	bytes_consumed = 0;
+		size_t	layers = 0; // Layers created, including the ones discarded by backtracking
+		size_t	array_func_retries = 0; // First parentheses of a declarator, that are read as parameter list rather than as group
+		size_t	array_func_backtracks = 0; // Sequences of array/function suffixes that were dropped
+		size_t	mem_ptr_backtracks = 0; // Names that turned out to be no member pointer
+		size_t	parameter_parses = 0; // Nested parses of function parameters
+		size_t	allocations = 0; // Heap allocations of layers, arguments and new symbols
 		
-		//! Default Ctor
-		type() : layers( 1 , { layer_type::type , content : "void" } ) {}
+		parse_stats& operator+=( const parse_stats& other ){
+			parses += other.parses;
+			bytes_consumed += other.bytes_consumed;
+			layers += other.layers;
+			array_func_retries += other.array_func_retries;
+			array_func_backtracks += other.array_func_backtracks;
+			mem_ptr_backtracks += other.mem_ptr_backtracks;
+			parameter_parses += other.parameter_parses;
+			allocations += other.allocations;
+			return *this;
+		}
+	};
+	
+	//! Function called after every parse with the parsed input and the counters of that parse
+	using parse_stats_callback = void(*)( std::string_view input , const parse_stats& stats );
+	
+	//! Returns the sum of the counters of all parses the calling thread performed (may be reset by assigning '{}')
+	inline parse_stats& thread_parse_stats(){
+		static thread_local parse_stats instance;
+		return instance;
+	}
+	
+	namespace detail
+	{
+		constexpr bool stats_enabled = CPP_TYPENAME_PARSER_STATS != 0;
 		
-		//! Ctor from C++ typename in string form
-		type( const char* val ){ if( val ) node_type( val ); }
-		type( const std::string& val ) : type( val.c_str() ) {}
-		type( const type& ) = default;
-		type( type&& ) = default;
-		type& operator=( const type& ) = default;
-		type& operator=( type&& ) = default;
+		inline std::atomic<parse_stats_callback> stats_callback{ nullptr };
 		
-		//! Comparison operator
-		bool operator==( const type& other ) const { return layers == other.layers; }
-		bool operator!=( const type& other ) const { return layers != other.layers; }
+		//! Counters of the parse in progress on this thread
+		inline parse_stats& current_parse_stats(){
+			static thread_local parse_stats instance;
+			return instance;
+		}
 		
-		//! Boolean conversion
-		explicit operator bool() const { return !layers.empty(); }
+		//! Adds 'n' to a counter of the parse in progress
+		inline void count( size_t parse_stats::* counter , size_t n = 1 ){
+			if constexpr( stats_enabled )
+				current_parse_stats().*counter += n;
+		}
 		
-		//! Iterator Interface
-		std::vector<layer>::iterator begin(){ return layers.begin(); }
-		std::vector<layer>::const_iterator begin() const { return layers.begin(); }
-		std::vector<layer>::const_iterator cbegin(){ return layers.cbegin(); }
-		std::vector<layer>::iterator end(){ return layers.end(); }
-		std::vector<layer>::const_iterator end() const { return layers.end(); }
-		std::vector<layer>::const_iterator cend(){ return layers.cbegin(); }
-		std::vector<layer>::reverse_iterator rbegin(){ return layers.rbegin(); }
-		std::vector<layer>::const_reverse_iterator rbegin() const { return layers.rbegin(); }
-		std::vector<layer>::const_reverse_iterator crbegin(){ return layers.crbegin(); }
-		std::vector<layer>::reverse_iterator rend(){ return layers.rend(); }
-		std::vector<layer>::const_reverse_iterator rend() const { return layers.rend(); }
-		std::vector<layer>::const_reverse_iterator crend(){ return layers.crbegin(); }
+		//! Appends to 'container' and counts the allocation, if its storage had to grow
+		template<typename Container , typename... Args>
+		void counted_emplace_back( Container& container , Args&&... args ){
+			if constexpr( stats_enabled ){
+				size_t capacity = container.capacity();
+				container.emplace_back( std::forward<Args>(args)... );
+				count( &parse_stats::allocations , container.capacity() != capacity );
+			}
+			else
+				container.emplace_back( std::forward<Args>(args)... );
+		}
 		
-		//! Convert this structure to a string representation (possibly to declare a variable 'name')
-		std::string to_string( std::string name = {} ) const
+		/**
+		 * Collects the counters of one parse of 'input'. Once finished, they are added to
+		 * thread_parse_stats() and passed to the callback set by set_parse_stats_callback().
+		 */
+		class parse_stats_scope
 		{
-			std::vector<std::string>	result;
-			layer						last_layer;
-			size_t						insert_pos = 0;
+		private:
 			
-			for( const layer& lr : layers ){
-				switch( lr.layer_type ){
-					case layer_type::type:
-						if( lr.is_const )
-							result.emplace( result.begin() + insert_pos++ , "const");
-						if( lr.is_volatile )
-							result.emplace( result.begin() + insert_pos++ , "volatile");
-						result.emplace( result.begin() + insert_pos++ , lr.content );
-						break;
-					case layer_type::array:
-						result.emplace( result.begin() + insert_pos , "]" );
-						result.emplace( result.begin() + insert_pos , lr.content );
-						result.emplace( result.begin() + insert_pos , "[" );
-						break;
-					case layer_type::function:{
-						result.emplace( result.begin() + insert_pos , ")" );
-						bool is_first = true;
-						for( auto it = lr.arguments.rbegin() ; it != lr.arguments.rend() ; it++ ){
-							if( !is_first )
-								result.emplace( result.begin() + insert_pos , "," );
-							else
-								is_first = false;
-							result.emplace( result.begin() + insert_pos , (*it)->to_string() );
-						}
-						result.emplace( result.begin() + insert_pos , "(" );
-						break;
-					}
-					case layer_type::pointer:
-					case layer_type::lvalue:
-					case layer_type::rvalue:
-					case layer_type::member_pointer:
-						static const char* lut[] = { "" , "*" , "&" , "&&" };
-						bool need_parens =
-							last_layer.layer_type == layer_type::array
-							|| last_layer.layer_type == layer_type::function
-							|| ( !is_primitive_type(result[insert_pos-1]) && lr.content.front() == ':' )
-						;
-						if( need_parens )
-							result.emplace( result.begin() + insert_pos++ , "(" );
-						if( lr.layer_type == layer_type::member_pointer )
-							result.emplace( result.begin() + insert_pos++ , lr.content + "::*" );
-						else
-							result.emplace( result.begin() + insert_pos++ , lut[(int)lr.layer_type] );
-						if( lr.is_const )
-							result.emplace( result.begin() + insert_pos++ , "const");
-						if( lr.is_volatile )
-							result.emplace( result.begin() + insert_pos++ , "volatile");
-						if( need_parens )
-							result.insert( result.begin() + insert_pos , ")" );
-						break;
-				}
-				last_layer = lr;
-			}
+			std::string_view	input;
+			parse_stats			outer; // Counters of an enclosing parse
 			
-			if( !name.empty() )
-				result.emplace( result.begin() + insert_pos , std::move(name) );
+		public:
 			
-			std::string output;
+			parse_stats_scope( std::string_view input ) : input( input ) {
+				if constexpr( stats_enabled ){
+					outer = current_parse_stats();
+					current_parse_stats() = parse_stats();
+					current_parse_stats().parses = 1;
+				}
+			}
+			parse_stats_scope( const parse_stats_scope& ) = delete;
 			
-			for( const auto& str : result ){
-				if( need_space( output.back() , str.front() ) )
-					output += ' ';
-				output += str;
+			//! Records, that the parse stopped at 'pos'
+			void finish( const char* pos ){
+				if constexpr( stats_enabled )
+					current_parse_stats().bytes_consumed = pos - input.data();
 			}
 			
-			return std::move(output);
-		}
-		
-		template<typename T>
-		static type from_type(){
-			type result{nullptr};
-			from_type_helper<T>::work( result );
+			~parse_stats_scope(){
+				if constexpr( stats_enabled ){
+					parse_stats stats = current_parse_stats();
+					current_parse_stats() = outer;
+					thread_parse_stats() += stats;
+					if( parse_stats_callback callback = stats_callback.load( std::memory_order_relaxed ) )
+						callback( input , stats );
+				}
+			}
+		};
+	}
+	
+	//! Sets the function to call after every parse (nullptr to remove it). Only used if CPP_TYPENAME_PARSER_STATS is set to 1
+	inline void set_parse_stats_callback( parse_stats_callback callback ){
+		detail::stats_callback.store( callback , std::memory_order_relaxed );
+	}
+	
+	struct template_argument;
+	using template_argument_list = std::vector<template_argument>;
+	
+	class type;
+	
+	namespace detail
+	{
+		//! Packs the first 8 characters of 'str' into an integer (the first character being the least significant byte)
+		constexpr std::uint64_t pack_word( std::string_view str ){
+			std::uint64_t result = 0;
+			for( size_t i = 0 ; i < str.size() && i < 8 ; i++ )
+				result |= std::uint64_t( static_cast<unsigned char>( str[i] ) ) << ( 8 * i );
 			return result;
 		}
+	}
+	
+	/**
+	 * Process-wide table of interned identifiers, i.e. datatype names, array extents and member pointer classes.
+	 * Every distinct string is stored once and referenced by a small integer id. Id 0 is the empty string,
+	 * the following ids are pre-seeded with the primitive keywords. The table only grows: Strings are kept until the process
+	 * ends, even once no type refers to them anymore (releasing a type_arena does not free them either). Since every distinct
+	 * name read from untrusted input stays in the table, set_memory_limit() bounds the memory it may take.
+	 * Interning is thread-safe (sharded by hash, strings already present only take a shared lock),
+	 * looking up the string of an id is lock-free.
+	 */
+	class symbol_table
+	{
+	public:
 		
-	public: //! MODIFIERS !//
+		using id_type = std::uint32_t;
 		
-		//! Sets the basic data type of this type object
-		void set_datatype( type t ){
-			if( !layers.empty() && layers.front().layer_type == layer_type::type )
-				layers.erase( layers.begin() );
-			layers.insert( layers.begin() , t.layers.begin() , t.layers.end() );
-		}
-		//! Adds a 'const' qualification to this type at the outermost level
-		void add_const(){
-			if( layers.empty() )
-				layers.push_back( { layer_type::type , "void" , true } );
-			switch( layers.back().layer_type ){
-				case layer_type::type:
-				case layer_type::pointer:
-				case layer_type::member_pointer:
-					layers.back().is_const = true;
-					break;
-				default:
-					break;
-			}
-		}
-		//! Adds a 'volatile' qualification to this type at the outermost level
-		void add_volatile(){
-			if( layers.empty() )
-				layers.push_back( { layer_type::type , "void" , false , true } );
-			switch( layers.back().layer_type ){
-				case layer_type::type:
-				case layer_type::pointer:
-				case layer_type::member_pointer:
-					layers.back().is_volatile = true;
-					break;
-				default:
-					break;
-			}
-		}
-		//! Adds a array qualification to this type at the outermost level
-		void add_array( int extent = -1 ){
-			if( layers.empty() )
-				layers.push_back( { layer_type::type , "void" } );
-			layers.push_back( { layer_type::array , extent > 0 ? detail::to_string(extent) : "" } );
-		}
-		//! Adds a function qualification to this type at the outermost level
-		void add_function( std::vector<std::shared_ptr<type>> parameters = {} ){
-			if( layers.empty() )
-				layers.push_back( { layer_type::type , "void" } );
-			layers.push_back( { layer_type::function , {} , false , false , parameters } );
+		static constexpr id_type	empty_id = 0;
+		static constexpr id_type	first_primitive_id = 1;
+		static constexpr id_type	num_primitives = 13;
+		
+		//! The table used by all types
+		static symbol_table& global(){
+			static symbol_table instance;
+			return instance;
 		}
-		//! Removes 'const' qualification of this type at the outermost level
-		void remove_const(){
-			if( !layers.empty() )
-				layers.back().is_const = false;
+		
+		//! Returns the id of 'str', adding it to the table if necessary
+		id_type intern( std::string_view str )
+		{
+			if( str.empty() )
+				return empty_id;
+			if( id_type id = find_primitive( str ) )
+				return id;
+			return insert( str );
 		}
-		//! Removes 'volatile' qualification of this type at the outermost level
-		void remove_volatile(){
-			if( !layers.empty() )
-				layers.back().is_volatile = false;
+		
+		//! Returns the string of the (previously interned) id
+		std::string_view lookup( id_type id ) const {
+			const entry& e = const_cast<symbol_table*>(this)->entry_at( id , false );
+			return { e.data , e.size };
 		}
-		//! Removes reference qualification of this type at the outermost level
-		void remove_reference(){
-			switch( layers.back().layer_type ){
-				case layer_type::lvalue:
-				case layer_type::rvalue:
-					layers.pop_back();
-					break;
-				default:
-					break;
-			}
+		
+		//! Returns the zero-terminated string of the (previously interned) id
+		const char* c_str( id_type id ) const {
+			return const_cast<symbol_table*>(this)->entry_at( id , false ).data;
 		}
-		//! Removes pointer, array or function qualification of this type at the outermost level
-		void remove_pointer(){
-			switch( layers.back().layer_type ){
-				case layer_type::pointer:
-				case layer_type::member_pointer:
-				case layer_type::function:
-				case layer_type::array:
-					layers.pop_back();
-					break;
-				default:
+		
+		//! Returns the number of interned strings
+		size_t size() const { return next_id.load( std::memory_order_relaxed ); }
+		
+		//! Returns the number of bytes taken by the interned strings and their entries
+		size_t memory_usage() const { return memory_used.load( std::memory_order_relaxed ); }
+		
+		//! Limits memory_usage() to 'bytes' (0 for no limit). Beyond it, interning a new string (e.g. while parsing a type) throws std::length_error
+		void set_memory_limit( size_t bytes ){ memory_limit.store( bytes , std::memory_order_relaxed ); }
+		
+		//! Returns the pre-seeded id of the primitive keyword 'str' or 'empty_id', if 'str' is no such keyword
+		static id_type find_primitive( std::string_view str ){
+			// Indices of the keywords with a certain length, terminated by -1
+			static const signed char candidates[9][4] = {
+				{ -1 } , { -1 } , { -1 } , { 6 , -1 } , { 0 , 4 , 7 , 12 } , { 5 , 10 , -1 } , { 8 , 11 , -1 } , { 3 , -1 } , { 1 , 2 , 9 , -1 }
+			};
+			// All keywords fit into 8 bytes: Compare them as integers instead of calling memcmp
+			static constexpr std::uint64_t keys[num_primitives] = {
+				detail::pack_word( "char" ) , detail::pack_word( "char16_t" ) , detail::pack_word( "char32_t" ) , detail::pack_word( "wchar_t" ) , detail::pack_word( "bool" ) , detail::pack_word( "short" )
+				, detail::pack_word( "int" ) , detail::pack_word( "long" ) , detail::pack_word( "signed" ) , detail::pack_word( "unsigned" ) , detail::pack_word( "float" ) , detail::pack_word( "double" ) , detail::pack_word( "void" )
+			};
+			if( str.size() >= 9 || candidates[str.size()][0] < 0 )
+				return empty_id;
+			std::uint64_t key = detail::pack_word( str );
+			for( signed char index : candidates[str.size()] ){
+				if( index < 0 )
 					break;
+				if( keys[index] == key )
+					return first_primitive_id + index;
 			}
+			return empty_id;
 		}
-		//! Resets this type to 'void'
-		void clear(){
-			*this = type();
-		}
-	public: //! INFORMATION RETRIEVAL !//
-	
-		std::string get_datatype() const {
-			return !layers.empty() && layers.front().layer_type == layer_type::type ? layers.front().content : std::string();
-		}
-		bool is_plain() const {
-			return layers.size() == 1 && layers.front().layer_type == layer_type::type;
-		}
-		bool is_lvalue_reference() const {
-			return !layers.empty() && layers.back().layer_type == layer_type::lvalue;
-		}
-		bool is_rvalue_reference() const {
-			return !layers.empty() && layers.back().layer_type == layer_type::rvalue;
-		}
-		bool is_array() const {
-			return !layers.empty() && layers.back().layer_type == layer_type::array;
-		}
-		bool is_pointer() const {
-			return !layers.empty() && layers.back().layer_type == layer_type::pointer;
-		}
-		bool is_member_pointer() const {
-			return !layers.empty() && layers.back().layer_type == layer_type::member_pointer;
-		}
-		bool is_const() const {
-			return !layers.empty() && layers.back().is_const;
-		}
-		bool is_volatile() const {
-			return !layers.empty() && layers.back().is_volatile;
-		}
-		bool is_void() const {
-			return layers.size() == 1 && layers.front().content == "void";
+		
+		//! Checks, whether 'id' refers to a primitive keyword
+		static bool is_primitive( id_type id ){
+			return id - first_primitive_id < num_primitives;
 		}
 		
-	private: //! PARSER STUFF !//
+		//! Returns the template arguments of the (previously interned) name 'id', which are parsed on the first request
+		const template_argument_list& template_arguments( id_type id );
 		
-		static void skip_spaces( const char*& input ){
-			while( std::isspace( *input ) )
-				input++;
-		}
+		//! Returns the id of the canonical spelling of the (previously interned) name 'id', which is computed on the first request
+		id_type canonical( id_type id );
 		
-		static bool need_space( char lhs , char rhs ){
-			if( std::isalpha( lhs ) )
-				return std::isalpha( rhs ) || rhs == '*' || rhs == '(' || rhs == ':' ;
-			if( lhs == '*' || lhs == ')' || lhs == ':' )
-				return std::isalpha( rhs );
-			return false;
-		}
+	private:
+		
+		static constexpr id_type	unknown_id = ~id_type(0);
+		
+		struct entry
+		{
+			const char*									data;
+			std::uint32_t								size;
+			std::atomic<const template_argument_list*>	template_arguments{ nullptr }; // Parsed lazily
+			std::atomic<id_type>						canonical_id{ unknown_id }; // Computed lazily
+		};
+		
+		struct shard
+		{
+			std::shared_mutex									mutex;
+			std::unordered_map<std::string_view, id_type>		ids;
+			std::pmr::monotonic_buffer_resource					storage;
+		};
+		
+		static constexpr size_t	num_shards = 16;
+		static constexpr size_t	first_bucket_bits = 6;
+		static constexpr size_t	num_buckets = 32 - first_bucket_bits;
 		
-		static bool is_primitive_type( std::string& str ){
-			static const char* primitive_types[13] = {
+		static const std::string_view* primitive_keywords(){
+			static const std::string_view keywords[num_primitives] = {
 				"char" , "char16_t" , "char32_t" , "wchar_t" , "bool" , "short"
 				, "int" , "long" , "signed" , "unsigned" , "float" , "double" , "void"
 			};
-			for( int i = 0 ; i < 13 ; i++ )
-				if( str == primitive_types[i] )
-					return true;
-			return false;
+			return keywords;
 		}
 		
-		/**
-		 * GRAMMAR:
-		 * 
-		 * <node_type>			:= <node_basic_type> [ <node_type_qual> ]
-		 * <node_basic_type>	:=
-		 *  -  { <node_cv_qual> } PRIMITIVE_TYPE { PRIMITIVE_TYPE | <node_cv_qual> }
-		 *  -  { <node_cv_qual> } ['::'] <node_name> { '::' <node_name> } { <node_cv_qual> }
-		 * <node_name>			:= [a-zA-Z_]+ [ '<' TEMPLATE_PARAMETERS '>' ]
-		 * <node_cv_qual>		:= 'const' | 'volatile'
-		 * <node_type_qual>		:= <node_ptr_or_ref> [ <node_type_qual> ] | <node_array_func>
-		 * <node_ptr_or_ref>	:= '*' { <node_cv_qual> } | '&' | '&&' | <node_mem_ptr>
-		 * <node_mem_ptr>		:= ['::'] <node_name> '::' { <node_name> '::' } '*' { <node_cv_qual> }
-		 * <node_array_func>	:=
-		 *  -  [ <node_array_func> ] '(' PARAMETERS ')' { <node_cv_qual> }
-		 *	-  [ <node_array_func> ] '[' CONSTANT ']'
-		 *	-  '(' <node_type_qual> ')'
-		*/
-		bool node_type( const char*& input )
-		{
-			layers.push_back( { layer_type::type } ); // <node_type>
-			skip_spaces( input );
-			if( !node_basic_type( input ) ){
-				layers.pop_back();
-				return false;
-			}
-			node_type_qual( input );
-			return true;
+		shard					shards[num_shards];
+		std::atomic<entry*>		buckets[num_buckets] = {}; // Bucket i holds 2^(first_bucket_bits+i) entries
+		std::mutex				buckets_mutex;
+		std::atomic<id_type>	next_id{ 0 };
+		std::atomic<size_t>		memory_used{ 0 };
+		std::atomic<size_t>		memory_limit{ 0 };
+		
+		symbol_table(){
+			entry& empty = entry_at( next_id++ , true ); // The empty string is never stored in a shard
+			empty.data = "";
+			empty.size = 0;
+			for( id_type i = 0 ; i < num_primitives ; i++ )
+				insert( primitive_keywords()[i] );
 		}
+		~symbol_table();
+		symbol_table( const symbol_table& ) = delete;
+		symbol_table& operator=( const symbol_table& ) = delete;
 		
-		/**
-		 * <node_basic_type>	:=
-		 *  -  { <node_cv_qual> } PRIMITIVE_TYPE { PRIMITIVE_TYPE | <node_cv_qual> }
-		 *  -  { <node_cv_qual> } ['::'] <node_name> { '::' <node_name> } { <node_cv_qual> }
+		//! Adds 'str' to the table, unless it is already present
+		id_type insert( std::string_view str )
+		{
+			size_t		hash = std::hash<std::string_view>()( str );
+			shard&		sh = shards[ ( hash >> 7 ) % num_shards ];
+			{
+				std::shared_lock<std::shared_mutex> lock( sh.mutex );
+				auto it = sh.ids.find( str );
+				if( it != sh.ids.end() )
+					return it->second;
+			}
+			
+			std::unique_lock<std::shared_mutex> lock( sh.mutex );
+			auto it = sh.ids.find( str );
+			if( it != sh.ids.end() ) // Interned concurrently
+				return it->second;
+			
+			size_t bytes = str.size() + 1 + sizeof(entry);
+			size_t limit = memory_limit.load( std::memory_order_relaxed );
+			if( limit && memory_used.load( std::memory_order_relaxed ) + bytes > limit )
+				throw std::length_error( "parser::symbol_table: memory limit exceeded" );
+			memory_used.fetch_add( bytes , std::memory_order_relaxed );
+			
+			// Copy the string (including a terminating zero) to the stable storage of the shard
+			char* data = static_cast<char*>( sh.storage.allocate( str.size() + 1 , 1 ) );
+			std::memcpy( data , str.data() , str.size() );
+			data[str.size()] = 0;
+			
+			id_type id = next_id.fetch_add( 1 , std::memory_order_relaxed );
+			entry& e = entry_at( id , true );
+			e.data = data;
+			e.size = static_cast<std::uint32_t>( str.size() );
+			detail::count( &parse_stats::allocations , id > num_primitives ); // Not counting the seeding of the table
+			sh.ids.emplace( std::string_view( data , str.size() ) , id );
+			return id;
+		}
+		
+		//! Returns the storage of id, whose bucket is created if 'allocate' is set
+		entry& entry_at( id_type id , bool allocate )
+		{
+			size_t index = size_t( id ) + ( size_t(1) << first_bucket_bits );
+			size_t bucket = detail::bit_width( index ) - 1 - first_bucket_bits;
+			size_t offset = index - ( size_t(1) << ( bucket + first_bucket_bits ) );
+			entry* entries = buckets[bucket].load( std::memory_order_acquire );
+			if( !entries && allocate ){
+				std::lock_guard<std::mutex> lock( buckets_mutex );
+				entries = buckets[bucket].load( std::memory_order_relaxed );
+				if( !entries ){
+					entries = new entry[ size_t(1) << ( bucket + first_bucket_bits ) ];
+					buckets[bucket].store( entries , std::memory_order_release );
+				}
+			}
+			return entries[offset];
+		}
+	};
+	
+	/**
+	 * Handle to a string interned in the global symbol_table.
+	 * Comparison of two symbols is an integer comparison.
+	 */
+	class symbol
+	{
+	private:
+		
+		symbol_table::id_type id_ = symbol_table::empty_id;
+		
+	public:
+		
+		symbol() = default;
+		symbol( std::string_view str ) : id_( symbol_table::global().intern( str ) ) {}
+		symbol( const char* str ) : symbol( std::string_view( str ) ) {}
+		symbol( const std::string& str ) : symbol( std::string_view( str ) ) {}
+		
+		//! Returns the id of this symbol in the global symbol_table
+		symbol_table::id_type id() const { return id_; }
+		
+		std::string_view view() const { return symbol_table::global().lookup( id_ ); }
+		const char* c_str() const { return symbol_table::global().c_str( id_ ); }
+		const char* data() const { return c_str(); }
+		operator std::string_view() const { return view(); }
+		
+		size_t size() const { return view().size(); }
+		bool empty() const { return id_ == symbol_table::empty_id; }
+		char front() const { return view().front(); }
+		char back() const { return view().back(); }
+		
+		//! Checks, whether this symbol is one of the (single-word) primitive keywords
+		bool is_primitive() const { return symbol_table::is_primitive( id_ ); }
+		
+		bool operator==( const symbol& other ) const { return id_ == other.id_; }
+		bool operator!=( const symbol& other ) const { return id_ != other.id_; }
+		bool operator==( std::string_view other ) const { return view() == other; }
+		bool operator!=( std::string_view other ) const { return view() != other; }
+		bool operator==( const char* other ) const { return view() == other; }
+		bool operator!=( const char* other ) const { return view() != other; }
+		
+		//! Returns the template arguments of the last component of this name (e.g. 'int' and 'long' for "ns::pair<int,long>")
+		const template_argument_list& template_arguments() const { return symbol_table::global().template_arguments( id_ ); }
+		
+		//! Returns the canonical spelling of this name (e.g. "unsigned int" for "int unsigned", see type::canonicalize())
+		symbol canonical() const { symbol result; result.id_ = symbol_table::global().canonical( id_ ); return result; }
+	};
+	
+	/**
+	 * Argument of a template-id within the content of a layer (see type::template_arguments()).
+	 * Either a type or, for non-type arguments, the expression as written.
+	 */
+	struct template_argument
+	{
+		std::shared_ptr<const type>	value; // Set, if the argument is a type
+		symbol						expression; // Set, if the argument is no type
+		
+		bool is_type() const { return value != nullptr; }
+	};
+	
+	/**
+	 * Monotonic memory resource to allocate many types from at once (using parser::type("int*", &arena)).
+	 * Layers and argument lists of all types parsed into the arena are freed in one shot by release().
+	 * (Contents are not part of the arena, since they are interned in the global symbol_table)
+	 * Types allocated from the arena must not be used after release() or destruction of the arena.
+	 */
+	class type_arena : public std::pmr::memory_resource
+	{
+	private:
+		
+		std::unique_ptr<std::byte[]>		initial_buffer;
+		std::pmr::monotonic_buffer_resource	resource;
+		
+	public:
+		
+		//! Ctor, the first 'initial_size' bytes are reused after every release()
+		explicit type_arena( size_t initial_size = 64 * 1024 )
+			: initial_buffer( new std::byte[initial_size] )
+			, resource( initial_buffer.get() , initial_size )
+		{}
+		
+		//! Frees all memory allocated from the arena
+		void release(){ resource.release(); }
+		
+	private:
+		
+		void* do_allocate( size_t bytes , size_t alignment ) override { return resource.allocate( bytes , alignment ); }
+		void do_deallocate( void* , size_t , size_t ) override {}
+		bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override { return this == &other; }
+	};
+	
+	//! Kinds of layers a type consists of
+	enum class layer_type : unsigned char
+	{
+		type // <node_type>
+		, pointer // <node_ptr_or_ref>.1
+		, lvalue // <node_ptr_or_ref>.2
+		, rvalue // <node_ptr_or_ref>.3
+		, member_pointer // <node_mem_ptr>
+		, function // <node_array_func>.1
+		, array // <node_array_func>.2
+	};
+	
+	namespace detail
+	{
+		//! ASCII character classes (independent of the locale)
+		enum char_class : unsigned char
+		{
+			char_space = 1
+			, char_alpha = 2
+			, char_digit = 4
+			, char_underscore = 8
+			, char_identifier_start = char_alpha | char_underscore
+			, char_identifier = char_alpha | char_digit | char_underscore
+		};
+		
+		struct char_class_table
+		{
+			unsigned char classes[256] = {};
+			
+			constexpr char_class_table(){
+				for( int c = 0 ; c < 256 ; c++ )
+					classes[c] =
+						( c == ' ' || ( c >= '\t' && c <= '\r' ) ? char_space : 0 )
+						| ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) ? char_alpha : 0 )
+						| ( c >= '0' && c <= '9' ? char_digit : 0 )
+						| ( c == '_' ? char_underscore : 0 )
+					;
+			}
+			
+			constexpr bool is( char c , unsigned char mask ) const { return classes[static_cast<unsigned char>( c )] & mask; }
+		};
+		
+		inline constexpr char_class_table char_classes{};
+		
+		constexpr bool is_space( char c ){ return char_classes.is( c , char_space ); }
+		constexpr bool is_alpha( char c ){ return char_classes.is( c , char_alpha ); }
+		constexpr bool is_identifier_start( char c ){ return char_classes.is( c , char_identifier_start ); }
+		constexpr bool is_identifier_char( char c ){ return char_classes.is( c , char_identifier ); }
+		
+		/**
+		 * Scanners for long inputs (e.g. demangled names of several kilobytes). Each comes as scalar version, SSE2 version
+		 * (x86 only) and AVX2 version (x86 with gcc or clang only), the best of which is selected at runtime on first use.
+		 */
+		namespace scan
+		{
+			//! Returns the first of the characters "<>()[]{}" within [pos,end) or 'end'
+			inline const char* find_bracket_scalar( const char* pos , const char* end ){
+				for( ; pos != end ; pos++ )
+					switch( *pos ){
+						case '<': case '>': case '(': case ')': case '[': case ']': case '{': case '}':
+							return pos;
+					}
+				return end;
+			}
+			
+			//! Returns the first non-identifier character within [pos,end) or 'end'
+			inline const char* skip_identifier_scalar( const char* pos , const char* end ){
+				while( pos != end && is_identifier_char( *pos ) )
+					pos++;
+				return pos;
+			}
+			
+			//! Returns a bit mask of the identifier characters within the 64 bytes at 'pos' (bit i refers to pos[i])
+			inline std::uint64_t identifier_mask64_scalar( const char* pos ){
+				std::uint64_t mask = 0;
+				for( int i = 0 ; i < 64 ; i++ )
+					mask |= std::uint64_t( is_identifier_char( pos[i] ) ) << i;
+				return mask;
+			}
+			
+			inline int count_trailing_zeros( unsigned mask ){
+				#if defined(_MSC_VER) && !defined(__clang__)
+				unsigned long index;
+				_BitScanForward( &index , mask );
+				return int( index );
+				#else
+				return __builtin_ctz( mask );
+				#endif
+			}
+			
+			inline int count_trailing_zeros( std::uint64_t mask ){
+				#if defined(_MSC_VER) && !defined(__clang__)
+				unsigned long index;
+				_BitScanForward64( &index , mask );
+				return int( index );
+				#else
+				return __builtin_ctzll( mask );
+				#endif
+			}
+			
+			#if CPP_TYPENAME_PARSER_SSE2
+			inline const char* find_bracket_sse2( const char* pos , const char* end )
+			{
+				// Pairs of brackets differ in a single bit: "()" in bit 0, "<>" in bit 1 and "[{" resp. "]}" in bit 5
+				const __m128i round = _mm_set1_epi8( '(' ) , angle = _mm_set1_epi8( '<' ) , open = _mm_set1_epi8( '{' ) , close = _mm_set1_epi8( '}' );
+				const __m128i clear_bit_0 = _mm_set1_epi8( ~1 ) , clear_bit_1 = _mm_set1_epi8( ~2 ) , set_bit_5 = _mm_set1_epi8( 0x20 );
+				for( ; end - pos >= 16 ; pos += 16 ){
+					__m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pos ) );
+					__m128i chunk_5 = _mm_or_si128( chunk , set_bit_5 );
+					__m128i matches = _mm_or_si128(
+						_mm_or_si128( _mm_cmpeq_epi8( _mm_and_si128( chunk , clear_bit_0 ) , round ) , _mm_cmpeq_epi8( _mm_and_si128( chunk , clear_bit_1 ) , angle ) )
+						, _mm_or_si128( _mm_cmpeq_epi8( chunk_5 , open ) , _mm_cmpeq_epi8( chunk_5 , close ) )
+					);
+					if( unsigned mask = unsigned( _mm_movemask_epi8( matches ) ) )
+						return pos + count_trailing_zeros( mask );
+				}
+				return find_bracket_scalar( pos , end );
+			}
+			
+			//! Returns a bit mask of the identifier characters in 'chunk'
+			inline unsigned identifier_mask_sse2( __m128i chunk )
+			{
+				// Signed comparisons: Bytes >= 0x80 are negative and therefore never within a range
+				const __m128i lower_a = _mm_set1_epi8( 'a' - 1 ) , lower_z = _mm_set1_epi8( 'z' + 1 );
+				const __m128i digit_0 = _mm_set1_epi8( '0' - 1 ) , digit_9 = _mm_set1_epi8( '9' + 1 );
+				const __m128i to_lower = _mm_set1_epi8( 0x20 ) , underscore = _mm_set1_epi8( '_' );
+				__m128i lower = _mm_or_si128( chunk , to_lower );
+				return unsigned( _mm_movemask_epi8( _mm_or_si128(
+					_mm_and_si128( _mm_cmpgt_epi8( lower , lower_a ) , _mm_cmplt_epi8( lower , lower_z ) )
+					, _mm_or_si128(
+						_mm_and_si128( _mm_cmpgt_epi8( chunk , digit_0 ) , _mm_cmplt_epi8( chunk , digit_9 ) )
+						, _mm_cmpeq_epi8( chunk , underscore )
+					)
+				) ) );
+			}
+			
+			inline const char* skip_identifier_sse2( const char* pos , const char* end )
+			{
+				for( ; end - pos >= 16 ; pos += 16 )
+					if( unsigned mask = ~identifier_mask_sse2( _mm_loadu_si128( reinterpret_cast<const __m128i*>( pos ) ) ) & 0xFFFF )
+						return pos + count_trailing_zeros( mask );
+				return skip_identifier_scalar( pos , end );
+			}
+			
+			inline std::uint64_t identifier_mask64_sse2( const char* pos )
+			{
+				std::uint64_t mask = 0;
+				for( int i = 0 ; i < 64 ; i += 16 )
+					mask |= std::uint64_t( identifier_mask_sse2( _mm_loadu_si128( reinterpret_cast<const __m128i*>( pos + i ) ) ) ) << i;
+				return mask;
+			}
+			#endif
+			
+			#if CPP_TYPENAME_PARSER_AVX2
+			__attribute__(( target( "avx2" ) ))
+			inline const char* find_bracket_avx2( const char* pos , const char* end )
+			{
+				const __m256i round = _mm256_set1_epi8( '(' ) , angle = _mm256_set1_epi8( '<' ) , open = _mm256_set1_epi8( '{' ) , close = _mm256_set1_epi8( '}' );
+				const __m256i clear_bit_0 = _mm256_set1_epi8( ~1 ) , clear_bit_1 = _mm256_set1_epi8( ~2 ) , set_bit_5 = _mm256_set1_epi8( 0x20 );
+				for( ; end - pos >= 32 ; pos += 32 ){
+					__m256i chunk = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pos ) );
+					__m256i chunk_5 = _mm256_or_si256( chunk , set_bit_5 );
+					__m256i matches = _mm256_or_si256(
+						_mm256_or_si256( _mm256_cmpeq_epi8( _mm256_and_si256( chunk , clear_bit_0 ) , round ) , _mm256_cmpeq_epi8( _mm256_and_si256( chunk , clear_bit_1 ) , angle ) )
+						, _mm256_or_si256( _mm256_cmpeq_epi8( chunk_5 , open ) , _mm256_cmpeq_epi8( chunk_5 , close ) )
+					);
+					if( unsigned mask = unsigned( _mm256_movemask_epi8( matches ) ) )
+						return pos + count_trailing_zeros( mask );
+				}
+				return find_bracket_sse2( pos , end );
+			}
+			
+			__attribute__(( target( "avx2" ) ))
+			inline unsigned identifier_mask_avx2( __m256i chunk )
+			{
+				const __m256i lower_a = _mm256_set1_epi8( 'a' - 1 ) , lower_z = _mm256_set1_epi8( 'z' + 1 );
+				const __m256i digit_0 = _mm256_set1_epi8( '0' - 1 ) , digit_9 = _mm256_set1_epi8( '9' + 1 );
+				const __m256i to_lower = _mm256_set1_epi8( 0x20 ) , underscore = _mm256_set1_epi8( '_' );
+				__m256i lower = _mm256_or_si256( chunk , to_lower );
+				return unsigned( _mm256_movemask_epi8( _mm256_or_si256(
+					_mm256_and_si256( _mm256_cmpgt_epi8( lower , lower_a ) , _mm256_cmpgt_epi8( lower_z , lower ) )
+					, _mm256_or_si256(
+						_mm256_and_si256( _mm256_cmpgt_epi8( chunk , digit_0 ) , _mm256_cmpgt_epi8( digit_9 , chunk ) )
+						, _mm256_cmpeq_epi8( chunk , underscore )
+					)
+				) ) );
+			}
+			
+			__attribute__(( target( "avx2" ) ))
+			inline const char* skip_identifier_avx2( const char* pos , const char* end )
+			{
+				for( ; end - pos >= 32 ; pos += 32 )
+					if( unsigned mask = ~identifier_mask_avx2( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pos ) ) ) )
+						return pos + count_trailing_zeros( mask );
+				return skip_identifier_sse2( pos , end );
+			}
+			
+			__attribute__(( target( "avx2" ) ))
+			inline std::uint64_t identifier_mask64_avx2( const char* pos ){
+				return identifier_mask_avx2( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pos ) ) )
+					| std::uint64_t( identifier_mask_avx2( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pos + 32 ) ) ) ) << 32;
+			}
+			#endif
+			
+			using scanner = const char*(*)( const char* pos , const char* end );
+			using mask_scanner = std::uint64_t(*)( const char* pos );
+			
+			struct implementation
+			{
+				scanner			find_bracket;
+				scanner			skip_identifier;
+				mask_scanner	identifier_mask64;
+			};
+			
+			//! Returns the fastest implementation supported by the CPU
+			inline implementation select()
+			{
+				#if CPP_TYPENAME_PARSER_AVX2
+				if( __builtin_cpu_supports( "avx2" ) )
+					return { &find_bracket_avx2 , &skip_identifier_avx2 , &identifier_mask64_avx2 };
+				#endif
+				#if CPP_TYPENAME_PARSER_SSE2
+				return { &find_bracket_sse2 , &skip_identifier_sse2 , &identifier_mask64_sse2 };
+				#else
+				return { &find_bracket_scalar , &skip_identifier_scalar , &identifier_mask64_scalar };
+				#endif
+			}
+			
+			inline const implementation& selected(){
+				static const implementation instance = select();
+				return instance;
+			}
+		}
+		
+		//! Returns the first of the characters "<>()[]{}" within [pos,end) or 'end'
+		inline const char* find_bracket( const char* pos , const char* end ){
+			return scan::selected().find_bracket( pos , end );
+		}
+		
+		//! Returns the first non-identifier character within [pos,end) or 'end'
+		inline const char* skip_identifier( const char* pos , const char* end ){
+			// Most identifiers are short: Only use the vectorized version, if the first 8 characters belong to the identifier
+			const char* limit = end - pos > 8 ? pos + 8 : end;
+			while( pos != limit && is_identifier_char( *pos ) )
+				pos++;
+			return pos == limit && pos != end ? scan::selected().skip_identifier( pos , end ) : pos;
+		}
+		
+		//! Returns a bit mask of the identifier characters within the 64 bytes at 'pos' (bit i refers to pos[i])
+		inline std::uint64_t identifier_mask64( const char* pos ){
+			return scan::selected().identifier_mask64( pos );
+		}
+		
+		/**
+		 * Read position within a (not necessarily zero-terminated) input buffer.
+		 * Reading at or beyond the end yields '\0', just like reading the terminator of a C string.
+		 */
+		struct cursor
+		{
+			const char*	pos;
+			const char*	end;
+			
+			constexpr cursor( std::string_view input ) : pos( input.data() ) , end( input.data() + input.size() ) {}
+			
+			constexpr char operator*() const { return pos != end ? *pos : '\0'; }
+			constexpr char operator[]( size_t offset ) const { return size_t( end - pos ) > offset ? pos[offset] : '\0'; }
+			constexpr cursor& operator++(){ ++pos; return *this; }
+			constexpr cursor operator++( int ){ cursor result = *this; ++pos; return result; }
+			constexpr cursor& operator+=( size_t offset ){ pos += offset; return *this; }
+			
+			//! Checks, whether the remaining input starts with 'str'
+			constexpr bool starts_with( std::string_view str ) const {
+				return size_t( end - pos ) >= str.size() && std::string_view( pos , str.size() ) == str;
+			}
+		};
+		
+		/**
+		 * Returns the '>' closing the '<' at 'pos', or 'end' if there is none.
+		 * Angle brackets inside parentheses, brackets or braces (as in "A<(1>2)>") are not counted.
+		 * This version is usable in constant expressions, at runtime find_matching_angle_bracket() is faster.
+		 */
+		constexpr const char* match_angle_bracket( const char* pos , const char* end )
+		{
+			int num_open_angles = 0;
+			int num_open_parens = 0;
+			for( ; pos != end ; pos++ ){
+				switch( *pos ){
+					case '(': case '[': case '{':
+						num_open_parens++;
+						break;
+					case ')': case ']': case '}':
+						if( --num_open_parens < 0 )
+							return end;
+						break;
+					case '<':
+						num_open_angles += !num_open_parens;
+						break;
+					case '>':
+						if( !num_open_parens && --num_open_angles == 0 )
+							return pos;
+						break;
+				}
+			}
+			return end;
+		}
+		
+		//! Like match_angle_bracket(), but skipping the characters in between brackets using find_bracket()
+		inline const char* find_matching_angle_bracket( const char* pos , const char* end )
+		{
+			int num_open_angles = 0;
+			int num_open_parens = 0;
+			for( ; ( pos = find_bracket( pos , end ) ) != end ; pos++ ){
+				switch( *pos ){
+					case '(': case '[': case '{':
+						num_open_parens++;
+						break;
+					case ')': case ']': case '}':
+						if( --num_open_parens < 0 )
+							return end;
+						break;
+					case '<':
+						num_open_angles += !num_open_parens;
+						break;
+					case '>':
+						if( !num_open_parens && --num_open_angles == 0 )
+							return pos;
+						break;
+				}
+			}
+			return end;
+		}
+		
+		/**
+		 * Assembles the content of a layer out of ranges of the input. As long as the content equals
+		 * a contiguous slice of the input, no characters are copied. Otherwise (e.g. "unsigned int" read from
+		 * "unsigned const int") the normalized content is assembled in the per-thread scratch buffer.
+		 */
+		class content_builder
+		{
+		private:
+			
+			const char*		limit; // End of the input
+			const char*		begin = nullptr;
+			const char*		end = nullptr;
+			std::string*	normalized = nullptr;
+		
+		public:
+			
+			content_builder( const cursor& input ) : limit( input.end ) {}
+			content_builder( const content_builder& ) = delete;
+			~content_builder(){ if( normalized ) normalized->clear(); }
+			
+			//! Appends the input range [first,last)
+			void append( const char* first , const char* last ){
+				if( !normalized ){
+					if( begin == end ){
+						begin = first;
+						end = last;
+						return;
+					}
+					if( first == end ){
+						end = last;
+						return;
+					}
+					normalized = &scratch_buffer();
+					normalized->assign( begin , end );
+				}
+				normalized->append( first , last );
+			}
+			
+			//! Appends the separator 'c', which is expected to be the next character within the input
+			void append( char c ){
+				if( !normalized && begin != end && end != limit && *end == c )
+					end++;
+				else
+					append( &c , &c + 1 );
+			}
+			
+			//! Shortens the content to 'length' characters
+			void truncate( size_t length ){
+				if( normalized )
+					normalized->resize( length );
+				else
+					end = begin + length;
+			}
+			
+			size_t size() const { return normalized ? normalized->size() : size_t( end - begin ); }
+			bool empty() const { return size() == 0; }
+			char back() const { return view().back(); }
+			
+			//! Checks, whether the content is a slice of the input
+			bool is_slice() const { return !normalized; }
+			
+			std::string_view view() const {
+				return normalized ? std::string_view( *normalized ) : std::string_view( begin , end - begin );
+			}
+		};
+		
+		//! Stores the content read by 'content' in a layer of 'type'
+		inline void assign_content( symbol& dest , const content_builder& content ){
+			dest = content.view();
+		}
+		//! Stores the content read by 'content' in a layer of 'type_view'
+		inline void assign_content( std::string_view& dest , const content_builder& content ){
+			dest = content.is_slice() ? content.view() : symbol( content.view() ).view();
+		}
+		
+		/**
+		 * Recursive descent parser, that fills the layers of 'Target' (either 'type' or 'type_view').
+		 * Target must provide:
+		 *  - a random access sequence 'layers', whose elements are constructible from a 'layer_type'
+		 *    and have the members 'layer_type', 'content', 'is_const', 'is_volatile' and 'arguments'
+		 *  - 'Target make_argument() const', returning an empty type to parse a parameter into
+		 *  - 'static void add_argument( layer& , Target&& )'
+		 *
+		 * GRAMMAR:
+		 *
+		 * <node_type>			:= <node_basic_type> [ <node_type_qual> ]
+		 * <node_basic_type>	:=
+		 *  -  { <node_cv_qual> } PRIMITIVE_TYPE { PRIMITIVE_TYPE | <node_cv_qual> }
+		 *  -  { <node_cv_qual> } ['::'] <node_name> { '::' <node_name> } { <node_cv_qual> }
+		 * <node_name>			:= [a-zA-Z_] [a-zA-Z_0-9]* [ '<' TEMPLATE_PARAMETERS '>' ]
+		 * <node_cv_qual>		:= 'const' | 'volatile'
+		 * <node_type_qual>		:= <node_ptr_or_ref> [ <node_type_qual> ] | <node_array_func>
+		 * <node_ptr_or_ref>	:= '*' { <node_cv_qual> } | '&' | '&&' | <node_mem_ptr>
+		 * <node_mem_ptr>		:= ['::'] <node_name> '::' { <node_name> '::' } '*' { <node_cv_qual> }
+		 * <node_array_func>	:=
+		 *  -  [ <node_array_func> ] '(' PARAMETERS ')' { <node_cv_qual> }
+		 *	-  [ <node_array_func> ] '[' CONSTANT ']'
+		 *	-  '(' <node_type_qual> ')'
+		 *
+		 * TEMPLATE_PARAMETERS are kept as text (see match_angle_bracket()) and only parsed by type::template_arguments().
+		*/
+		template<typename Target>
+		struct grammar
+		{
+			//! Maximum number of nested parentheses, beyond which parsing of a declarator fails
+			static constexpr int max_nesting_depth = 256;
+			
+			static void skip_spaces( cursor& input ){
+				while( is_space( *input ) )
+					input++;
+			}
+			
+			static bool is_primitive_type( std::string_view str ){
+				return symbol_table::find_primitive( str ) != symbol_table::empty_id;
+			}
+			
+			static void add_layer( Target& t , layer_type kind ){
+				count( &parse_stats::layers );
+				counted_emplace_back( t.layers , kind );
+			}
+			
+			//! <node_type>			:= <node_basic_type> [ <node_type_qual> ]
+			static bool node_type( Target& t , cursor& input , int depth = 0 )
+			{
+				add_layer( t , layer_type::type ); // <node_type>
+				skip_spaces( input );
+				if( !node_basic_type( t , input ) ){
+					t.layers.pop_back();
+					return false;
+				}
+				node_type_qual( t , input , depth );
+				return true;
+			}
+			
+			/**
+			 * <node_basic_type>	:=
+			 *  -  { <node_cv_qual> } PRIMITIVE_TYPE { PRIMITIVE_TYPE | <node_cv_qual> }
+			 *  -  { <node_cv_qual> } ['::'] <node_name> { '::' <node_name> } { <node_cv_qual> }
+			 */
+			static bool node_basic_type( Target& t , cursor& input )
+			{
+				cursor				input_backup = input;
+				content_builder		content( input );
+				size_t				content_length;
+				bool				primitive = true;
+			
+			read_word:
+				
+				while( node_cv_qual( t , input ) );
+				
+				input_backup = input;
+				content_length = content.size();
+				
+				if( content_length > 0 && ( !primitive || !is_identifier_start( *input ) ) )
+					; // Only primitive types consist of multiple words
+				else if( content_length > 0 )
+				{
+					content.append( ' ' );
+					node_name( input , content );
+					
+					// If the type is primitive, the type is allowed to consist of more than one word
+					if( is_primitive_type( content.view().substr( content_length + 1 ) ) )
+						goto read_word;
+					
+					content.truncate( content_length );
+					input = input_backup;
+				}
+				else if( node_name( input , content ) ){
+					primitive = is_primitive_type( content.view() );
+					goto read_word;
+				}
+				
+				if( // A Class in global scope!
+					( !primitive || content.empty() )
+					&& input[0] == ':'
+					&& input[1] == ':'
+					&& is_identifier_start( input[2] )
+				){
+					content.append( input.pos , input.pos + 2 );
+					input += 2; // Read the '::'
+					node_name( input , content );
+					primitive = false;
+					goto read_word;
+				}
+				
+				if( content.empty() )
+					return false;
+				assign_content( t.layers.back().content , content );
+				return true;
+			}
+			
+			//! <node_name>			:= [a-zA-Z_] [a-zA-Z_0-9]* [ '<' TEMPLATE_PARAMETERS '>' ]
+			static bool node_name( cursor& input , content_builder& dest )
+			{
+				if( !is_identifier_start( *input ) )
+					return false;
+				
+				const char* name_begin = input.pos;
+				input.pos = skip_identifier( input.pos + 1 , input.end );
+				dest.append( name_begin , input.pos );
+				
+				skip_spaces( input );
+				
+				if( *input == '<' )
+				{
+					const char* close = find_matching_angle_bracket( input.pos , input.end );
+					
+					// Check Postconditions
+					if( close != input.end ){
+						dest.append( input.pos , close + 1 );
+						input.pos = close + 1; // Read the '>'
+						skip_spaces( input );
+					}
+				}
+				
+				return true;
+			}
+			
+			//! <node_cv_qual>		:= 'const' | 'volatile'
+			static bool node_cv_qual( Target& t , cursor& input ){
+				if( input.starts_with( "const" ) ){
+					input += 5;
+					t.layers.back().is_const = true;
+				}
+				else if( input.starts_with( "volatile" ) ){
+					input += 8;
+					t.layers.back().is_volatile = true;
+				}
+				else
+					return false;
+				skip_spaces( input );
+				return true;
+			}
+			
+			//! <node_type_qual>		:= <node_ptr_or_ref> [ <node_type_qual> ] | <node_array_func>
+			static bool node_type_qual( Target& t , cursor& input , int depth ){
+				if( !node_ptr_or_ref( t , input ) )
+					return node_array_func( t , input , depth );
+				while( node_ptr_or_ref( t , input ) );
+				node_array_func( t , input , depth );
+				return true;
+			}
+			
+			//! <node_ptr_or_ref>	:= '*' { <node_cv_qual> } | '&' | '&&' | <node_mem_ptr>
+			static bool node_ptr_or_ref( Target& t , cursor& input ){
+				if( *input == '*' ){
+					add_layer( t , layer_type::pointer ); // <node_ptr_or_ref>.1
+					input++;
+					skip_spaces( input );
+					while( node_cv_qual( t , input ) );
+					return true;
+				}
+				if( *input == '&' ){
+					if( input[1] == '&' ){
+						add_layer( t , layer_type::rvalue ); // <node_ptr_or_ref>.3
+						input++;
+					}
+					else
+						add_layer( t , layer_type::lvalue ); // <node_ptr_or_ref>.2
+					input++;
+					skip_spaces( input );
+					return true;
+				}
+				if( node_mem_ptr( t , input ) )
+					return true;
+				return false;
+			}
+			
+			//! <node_mem_ptr>		:= ['::'] <node_name> '::' { <node_name> '::' } '*' { <node_cv_qual> }
+			static bool node_mem_ptr( Target& t , cursor& input )
+			{
+				cursor				backup = input;
+				content_builder		content( input );
+			
+			start:
+				if( input[0] == ':' && input[1] == ':' ){
+					content.append( input.pos , input.pos + 2 );
+					input += 2;
+					skip_spaces( input );
+					goto start;
+				}
+				else if( node_name( input , content ) )
+					goto start;
+				
+				if( content.empty() || content.back() != ':' || *input != '*' ){ // Backtrace
+					count( &parse_stats::mem_ptr_backtracks , !content.empty() );
+					input = backup;
+					return false;
+				}
+				
+				// Remove the trailing '::'
+				content.truncate( content.size() - 2 );
+				
+				input++; // Read in the '*'
+				skip_spaces( input );
+				
+				add_layer( t , layer_type::member_pointer ); // <node_type>
+				assign_content( t.layers.back().content , content );
+				
+				while( node_cv_qual( t , input ) );
+				
+				// skip_spaces( input ); // Unnecessary, since node_ptr_or_ref also invokes skip_spaces( input ) after call to node_mem_ptr
+				
+				return true;
+			}
+			
+			//! Checks, whether the text after a '(' starts like '(' <node_type_qual> ')', i.e. with '*', '&', '(', '[' or a member pointer
+			static bool starts_declarator( Target& t , cursor input ){
+				if( *input == '*' || *input == '&' || *input == '(' || *input == '[' )
+					return true;
+				size_t num_layers = t.layers.size();
+				if( !node_mem_ptr( t , input ) )
+					return false;
+				t.layers.resize( num_layers );
+				return true;
+			}
+			
+			/**
+			 * <node_array_func>	:=
+			 *  -  [ <node_array_func> ] '(' PARAMETERS ')' { <node_cv_qual> }
+			 *	-  [ <node_array_func> ] '[' CONSTANT ']'
+			 *	-  '(' <node_type_qual> ')'
+			 */
+			static bool node_array_func( Target& t , cursor& input , int depth )
+			{
+				auto&		layers = t.layers;
+				cursor		input_backup = input;
+				size_t		insert_pos = layers.size();
+				size_t		num_group_layers = 0; // Number of layers read by '(' <node_type_qual> ')'
+				bool		is_first = true;
+				
+				// Every suffix is appended to 'layers' in the order it is read. Since suffixes
+				// bind from the inside out, they are reversed once the whole sequence is known.
+				while( *input && *input != ')' && *input != ',' )
+				{
+					if( *input == '[' ) // Must be array
+					{
+						input++;
+						skip_spaces( input );
+						int				open_parens = 0;
+						content_builder	content( input );
+						const char*		content_begin = input.pos;
+						while( ( input.pos = find_bracket( input.pos , input.end ) ) != input.end ){
+							if( *input == '[' )
+								open_parens++;
+							else if( *input == ']' && open_parens-- == 0 )
+								break;
+							input++;
+						}
+						if( !*input )
+							goto backtrack;
+						content.append( content_begin , input.pos );
+						add_layer( t , layer_type::array ); // <node_array_func>.2
+						assign_content( layers.back().content , content );
+						input++; // Read the ']'
+						skip_spaces( input );
+					}
+					else if( *input == '(' )
+					{
+						if( depth >= max_nesting_depth )
+							goto backtrack;
+						input++;
+						skip_spaces( input );
+						if( is_first && starts_declarator( t , input ) ){
+							// PARAMETERS never start like this, so the group is not parsed again as such (which would take exponential time)
+							if( !node_type_qual( t , input , depth + 1 ) || *input != ')' )
+								goto backtrack;
+							num_group_layers = layers.size() - insert_pos;
+							input++;
+							skip_spaces( input );
+						}
+						else{ // Must be PARAMETERS
+							count( &parse_stats::array_func_retries , is_first );
+							add_layer( t , layer_type::function ); // <node_array_func>.1
+							while( *input != ')' ){
+								Target param = t.make_argument();
+								cursor input_backup_3 = input;
+								count( &parse_stats::parameter_parses );
+								if( !node_type( param , input , depth + 1 ) ){ // Read in one parameter
+									input = input_backup_3;
+									break;
+								}
+								Target::add_argument( layers.back() , std::move(param) );
+								if( *input != ',' )
+									break;
+								input++; // Read the ','
+								skip_spaces( input );
+							}
+							if( *input != ')' )
+								goto backtrack;
+							
+							input++; // Read the ')'
+							skip_spaces( input );
+							while( node_cv_qual( t , input ) );
+						}
+					}
+					else if( is_first )
+						goto backtrack;
+					else
+						break; // The suffixes end before any other character (e.g. a declarator-id)
+					
+					is_first = false;
+				}
+				
+				if( is_first )
+					return false;
+				
+				std::reverse( layers.begin() + insert_pos + num_group_layers , layers.end() );
+				std::rotate( layers.begin() + insert_pos , layers.begin() + insert_pos + num_group_layers , layers.end() );
+				return true;
+			
+			backtrack:
+				
+				// Restore
+				count( &parse_stats::array_func_backtracks );
+				input = input_backup;
+				layers.resize( insert_pos );
+				return false;
+			}
+		};
+		
+		//! Checks, whether the content of a layer is one of the primitive keywords
+		inline bool is_primitive_content( const symbol& content ){ return content.is_primitive(); }
+		inline bool is_primitive_content( std::string_view content ){ return symbol_table::find_primitive( content ) != symbol_table::empty_id; }
+		
+		//! Accesses an argument of a function layer
+		template<typename T>
+		const T& deref_argument( const std::shared_ptr<T>& arg ){ return *arg; }
+		template<typename T>
+		const T& deref_argument( const T& arg ){ return arg; }
+		
+		/**
+		 * Writes C++ declarations of types given by their layers (used by the to_string() methods).
+		 * The declarator is written in a single pass: first the prefix of every layer (innermost to outermost),
+		 * then the name, then the suffixes of every layer (outermost to innermost).
+		 */
+		struct emitter
+		{
+			static bool need_space( char lhs , char rhs ){
+				if( is_alpha( lhs ) )
+					return is_alpha( rhs ) || rhs == '*' || rhs == '(' || rhs == ':' ;
+				if( lhs == '*' || lhs == ')' || lhs == ':' )
+					return is_alpha( rhs );
+				return false;
+			}
+			
+			//! Appends 'token' to 'output', separated by a space from the preceding token (written after 'start') if required
+			static void append_token( std::string& output , size_t start , std::string_view token ){
+				if( token.empty() )
+					return;
+				if( output.size() > start && need_space( output.back() , token.front() ) )
+					output += ' ';
+				output += token;
+			}
+			
+			//! Checks, whether the pointer/reference layer at 'index' must be put in parentheses
+			template<typename Layers>
+			static bool need_parens( const Layers& layers , size_t index ){
+				if( index == 0 )
+					return false;
+				const auto& last_layer = layers[index-1];
+				return
+					last_layer.layer_type == layer_type::array
+					|| last_layer.layer_type == layer_type::function
+					|| (
+						!layers[index].content.empty() && layers[index].content.front() == ':'
+						&& !( last_layer.layer_type == layer_type::type && is_primitive_content( last_layer.content ) )
+					)
+				;
+			}
+			
+			template<typename Layers>
+			static void write( std::string& output , const Layers& layers , std::string_view name )
+			{
+				size_t start = output.size();
+				
+				for( size_t i = 0 ; i < layers.size() ; i++ ){
+					const auto& lr = layers[i];
+					switch( lr.layer_type ){
+						case layer_type::type:
+							if( lr.is_const )
+								append_token( output , start , "const" );
+							if( lr.is_volatile )
+								append_token( output , start , "volatile" );
+							append_token( output , start , lr.content );
+							break;
+						case layer_type::pointer:
+						case layer_type::lvalue:
+						case layer_type::rvalue:
+						case layer_type::member_pointer:
+							static const char* lut[] = { "" , "*" , "&" , "&&" };
+							if( need_parens( layers , i ) )
+								append_token( output , start , "(" );
+							if( lr.layer_type == layer_type::member_pointer ){
+								append_token( output , start , lr.content.empty() ? std::string_view( "::*" ) : std::string_view( lr.content ) );
+								if( !lr.content.empty() )
+									output += "::*";
+							}
+							else
+								append_token( output , start , lut[(int)lr.layer_type] );
+							if( lr.is_const )
+								append_token( output , start , "const" );
+							if( lr.is_volatile )
+								append_token( output , start , "volatile" );
+							break;
+						default:
+							break;
+					}
+				}
+				
+				append_token( output , start , name );
+				
+				for( size_t i = layers.size() ; i-- > 0 ; ){
+					const auto& lr = layers[i];
+					switch( lr.layer_type ){
+						case layer_type::array:
+							append_token( output , start , "[" );
+							append_token( output , start , lr.content );
+							append_token( output , start , "]" );
+							break;
+						case layer_type::function:{
+							append_token( output , start , "(" );
+							bool is_first = true;
+							for( const auto& arg : lr.arguments ){
+								if( !is_first )
+									append_token( output , start , "," );
+								else
+									is_first = false;
+								deref_argument( arg ).to_string( output , {} );
+							}
+							append_token( output , start , ")" );
+							if( lr.is_const )
+								append_token( output , start , "const" );
+							if( lr.is_volatile )
+								append_token( output , start , "volatile" );
+							break;
+						}
+						case layer_type::type:
+							break;
+						default:
+							if( need_parens( layers , i ) )
+								append_token( output , start , ")" );
+							break;
+					}
+				}
+			}
+		};
+	}
+	
+	namespace detail
+	{
+		/**
+		 * Sequence container, that stores up to N elements within the object itself and only allocates
+		 * (from a polymorphic allocator) once it grows beyond. Elements are created by uses-allocator construction,
+		 * i.e. as T( std::allocator_arg , allocator , args... ), and must be movable within one container.
+		 */
+		template<typename T, size_t N>
+		class inline_vector
+		{
+		public:
+			
+			using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+			using value_type = T;
+			using iterator = T*;
+			using const_iterator = const T*;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+			
+		private:
+			
+			std::uint32_t	size_ = 0;
+			std::uint32_t	capacity_ = N;
+			allocator_type	alloc;
+			union{
+				T*									heap; // If capacity_ > N
+				alignas(T) unsigned char			buffer[N * sizeof(T)];
+			};
+			
+			T* data_ptr(){ return capacity_ > N ? heap : reinterpret_cast<T*>( buffer ); }
+			const T* data_ptr() const { return capacity_ > N ? heap : reinterpret_cast<const T*>( buffer ); }
+			
+			void deallocate(){
+				if( capacity_ > N )
+					alloc.resource()->deallocate( heap , capacity_ * sizeof(T) , alignof(T) );
+			}
+			
+			//! Moves all elements into a new buffer of 'capacity' elements
+			void grow( size_t capacity ){
+				T* storage = static_cast<T*>( alloc.resource()->allocate( capacity * sizeof(T) , alignof(T) ) );
+				T* old = data_ptr();
+				for( size_t i = 0 ; i < size_ ; i++ ){
+					new( storage + i ) T( std::allocator_arg , alloc , std::move(old[i]) );
+					old[i].~T();
+				}
+				deallocate();
+				heap = storage;
+				capacity_ = std::uint32_t( capacity );
+			}
+			
+			//! Takes the elements of 'other' (which must be empty)
+			void take( inline_vector&& other ){
+				if( other.capacity_ > N && other.alloc == alloc ){ // Steal the buffer
+					heap = other.heap;
+					size_ = std::exchange( other.size_ , 0 );
+					capacity_ = std::exchange( other.capacity_ , std::uint32_t( N ) );
+				}
+				else{
+					reserve( other.size() );
+					for( T& element : other )
+						emplace_back( std::move(element) );
+					other.clear();
+				}
+			}
+			
+			template<typename Other>
+			void append_all( Other&& other ){
+				reserve( other.size() );
+				for( auto& element : other )
+					emplace_back( std::forward<decltype(element)>( element ) );
+			}
+			
+		public:
+			
+			explicit inline_vector( allocator_type alloc = {} ) : alloc( alloc ) {}
+			inline_vector( const inline_vector& other , allocator_type alloc = {} ) : alloc( alloc ) { append_all( other ); }
+			inline_vector( inline_vector&& other ) : inline_vector( std::move(other) , other.alloc ) {}
+			inline_vector( inline_vector&& other , allocator_type alloc ) : alloc( alloc ) { take( std::move(other) ); }
+			inline_vector& operator=( const inline_vector& other ){
+				if( this != &other ){
+					clear();
+					append_all( other );
+				}
+				return *this;
+			}
+			inline_vector& operator=( inline_vector&& other ){
+				if( this != &other ){
+					clear();
+					deallocate();
+					capacity_ = N;
+					take( std::move(other) );
+				}
+				return *this;
+			}
+			~inline_vector(){ clear(); deallocate(); }
+			
+			allocator_type get_allocator() const { return alloc; }
+			
+			size_t size() const { return size_; }
+			size_t capacity() const { return capacity_; }
+			bool empty() const { return size_ == 0; }
+			
+			T* data(){ return data_ptr(); }
+			const T* data() const { return data_ptr(); }
+			T& operator[]( size_t index ){ return data_ptr()[index]; }
+			const T& operator[]( size_t index ) const { return data_ptr()[index]; }
+			T& front(){ return data_ptr()[0]; }
+			const T& front() const { return data_ptr()[0]; }
+			T& back(){ return data_ptr()[size_ - 1]; }
+			const T& back() const { return data_ptr()[size_ - 1]; }
+			
+			iterator begin(){ return data_ptr(); }
+			const_iterator begin() const { return data_ptr(); }
+			const_iterator cbegin() const { return data_ptr(); }
+			iterator end(){ return data_ptr() + size_; }
+			const_iterator end() const { return data_ptr() + size_; }
+			const_iterator cend() const { return data_ptr() + size_; }
+			reverse_iterator rbegin(){ return reverse_iterator( end() ); }
+			const_reverse_iterator rbegin() const { return const_reverse_iterator( end() ); }
+			const_reverse_iterator crbegin() const { return const_reverse_iterator( end() ); }
+			reverse_iterator rend(){ return reverse_iterator( begin() ); }
+			const_reverse_iterator rend() const { return const_reverse_iterator( begin() ); }
+			const_reverse_iterator crend() const { return const_reverse_iterator( begin() ); }
+			
+			void reserve( size_t capacity ){
+				if( capacity > capacity_ )
+					grow( capacity );
+			}
+			
+			template<typename... Args>
+			T& emplace_back( Args&&... args ){
+				if( size_ == capacity_ )
+					grow( 2 * capacity_ );
+				T* result = new( data_ptr() + size_ ) T( std::allocator_arg , alloc , std::forward<Args>(args)... );
+				size_++;
+				return *result;
+			}
+			
+			void pop_back(){ data_ptr()[--size_].~T(); }
+			
+			void resize( size_t size ){
+				while( size_ > size )
+					pop_back();
+				while( size_ < size )
+					emplace_back();
+			}
+			
+			void clear(){ resize( 0 ); }
+			
+			iterator erase( const_iterator pos ){
+				iterator first = begin() + ( pos - begin() );
+				std::move( first + 1 , end() , first );
+				pop_back();
+				return first;
+			}
+			
+			template<typename InputIt>
+			iterator insert( const_iterator pos , InputIt first , InputIt last ){
+				size_t index = pos - begin();
+				size_t old_size = size_;
+				for( ; first != last ; ++first )
+					emplace_back( *first );
+				std::rotate( begin() + index , begin() + old_size , end() );
+				return begin() + index;
+			}
+			
+			bool operator==( const inline_vector& other ) const { return std::equal( begin() , end() , other.begin() , other.end() ); }
+			bool operator!=( const inline_vector& other ) const { return !( *this == other ); }
+		};
+	}
+	
+	namespace detail{ class mangled_decoder; }
+	class database_type;
+	class persistent_type;
+	class lazy_type;
+	class type_table;
+	class pattern_set;
+	class type_universe;
+	
+	/**
+	 * Use this class to parse (using parser::type("const int (*)[4]") )
+	 * or to generate (using myType.to_string()) C++ typenames
+	 */
+	class type
+	{
+	public:
+		
+		using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+		using layer_type = parser::layer_type;
+	
+	private:
+		
+		/**
+		 * Parameters of a function layer. They are kept out of line, so layers of other kinds only hold a null pointer.
+		 * The list itself is allocated (with the allocator of the type) when its function layer is created.
+		 */
+		class argument_list
+		{
+		private:
+			
+			using list = std::pmr::vector<std::shared_ptr<type>>;
+			
+			list* items = nullptr;
+			
+			static list* create( allocator_type alloc ){
+				return new( alloc.resource()->allocate( sizeof(list) , alignof(list) ) ) list( alloc );
+			}
+			
+		public:
+			
+			using value_type = std::shared_ptr<type>;
+			using iterator = value_type*;
+			using const_iterator = const value_type*;
+			using allocator_type = list::allocator_type;
+			
+			argument_list() = default;
+			explicit argument_list( type::allocator_type alloc ) : items( create( alloc ) ) {}
+			argument_list( argument_list&& other ) : items( std::exchange( other.items , nullptr ) ) {}
+			argument_list& operator=( argument_list&& other ){ std::swap( items , other.items ); return *this; }
+			~argument_list(){
+				if( !items )
+					return;
+				std::pmr::memory_resource* resource = items->get_allocator().resource();
+				items->~list();
+				resource->deallocate( items , sizeof(list) , alignof(list) );
+			}
+			
+			//! Copies 'other' into a list with the allocator 'alloc'. Arguments are shared if both have the same allocator, otherwise they are cloned
+			static argument_list copy( const argument_list& other , type::allocator_type alloc ){
+				argument_list result;
+				if( !other.items )
+					return result;
+				result.items = create( alloc );
+				if( other.get_allocator() == alloc )
+					*result.items = *other.items;
+				else{
+					result.items->reserve( other.size() );
+					for( const auto& arg : other )
+						result.items->push_back( std::allocate_shared<type>( result.get_allocator() , *arg ) );
+				}
+				return result;
+			}
+			static argument_list copy( argument_list&& other , type::allocator_type alloc ){
+				return other.get_allocator() == alloc ? std::move(other) : copy( other , alloc );
+			}
+			
+			allocator_type get_allocator() const { return items ? items->get_allocator() : allocator_type(); }
+			
+			size_t size() const { return items ? items->size() : 0; }
+			bool empty() const { return size() == 0; }
+			
+			iterator begin(){ return items ? items->data() : nullptr; }
+			const_iterator begin() const { return items ? items->data() : nullptr; }
+			iterator end(){ return begin() + size(); }
+			const_iterator end() const { return begin() + size(); }
+			std::reverse_iterator<const_iterator> rbegin() const { return std::reverse_iterator<const_iterator>( end() ); }
+			std::reverse_iterator<const_iterator> rend() const { return std::reverse_iterator<const_iterator>( begin() ); }
+			value_type& operator[]( size_t index ){ return (*items)[index]; }
+			const value_type& operator[]( size_t index ) const { return (*items)[index]; }
+			
+			//! Modifiers (only valid for the arguments of a function layer)
+			void reserve( size_t size ){ items->reserve( size ); }
+			void push_back( value_type arg ){ items->push_back( std::move(arg) ); }
+			template<typename... Args>
+			value_type& emplace_back( Args&&... args ){ return items->emplace_back( std::forward<Args>(args)... ); }
+			template<typename InputIt>
+			void assign( InputIt first , InputIt last ){ items->assign( first , last ); }
+			void clear(){ if( items ) items->clear(); }
+			size_t capacity() const { return items ? items->capacity() : 0; }
+		};
+		
+		/**
+		 * One layer of a type: Its kind and cv-qualifiers share one byte, the content is a handle into the
+		 * global symbol_table and the arguments are a pointer (only set for function layers).
+		 */
+		struct layer
+		{
+			using allocator_type = type::allocator_type;
+			
+			type::layer_type					layer_type : 3;
+			bool								is_const : 1;
+			bool								is_volatile : 1;
+			symbol								content; // Interned in the global symbol_table
+			argument_list						arguments;
+			
+			layer(
+				std::allocator_arg_t , allocator_type alloc
+				, type::layer_type layer_type = type::layer_type::type , symbol content = {}
+				, bool is_const = false , bool is_volatile = false
+			)
+				: layer_type( layer_type ) , is_const( is_const ) , is_volatile( is_volatile ) , content( content )
+			{
+				if( layer_type == type::layer_type::function )
+					arguments = argument_list( alloc );
+			}
+			layer( std::allocator_arg_t , allocator_type alloc , const layer& other )
+				: layer_type( other.layer_type ) , is_const( other.is_const ) , is_volatile( other.is_volatile ) , content( other.content )
+				, arguments( argument_list::copy( other.arguments , alloc ) )
+			{}
+			layer( std::allocator_arg_t , allocator_type alloc , layer&& other )
+				: layer_type( other.layer_type ) , is_const( other.is_const ) , is_volatile( other.is_volatile ) , content( other.content )
+				, arguments( argument_list::copy( std::move(other.arguments) , alloc ) )
+			{}
+			layer( const layer& other ) : layer( std::allocator_arg , {} , other ) {}
+			layer( layer&& ) = default;
+			
+			//! Layers are only moved within the same type, so arguments are taken over as they are
+			layer& operator=( layer&& ) = default;
+			layer& operator=( const layer& ) = delete;
+			
+			bool operator==( const layer& other ) const {
+				return
+					layer_type == other.layer_type
+					&& is_const == other.is_const
+					&& is_volatile == other.is_volatile
+					&& content == other.content
+					&& std::equal(
+						arguments.begin() , arguments.end() , other.arguments.begin() , other.arguments.end()
+						, []( const std::shared_ptr<type>& lhs , const std::shared_ptr<type>& rhs ){ return lhs == rhs || *lhs == *rhs; }
+					)
+				;
+			}
+			bool operator!=( const layer& other ) const { return !( *this == other ); }
+		};
+		
+		static_assert( sizeof(layer) <= 8 + sizeof(void*) , "A layer consists of one byte for kind and cv-qualifiers, a symbol and a pointer" );
+		
+		//! Most types have at most 4 layers, which are stored within the type itself
+		using layer_list = detail::inline_vector<layer, 4>;
+		
+		layer_list layers;
+		mutable std::atomic<size_t> cached_hash{ 0 }; // 0, if not computed yet
+		
+		template<typename> friend struct detail::grammar;
+		friend class type_view;
+		friend class detail::mangled_decoder;
+		template<size_t> friend class static_type;
+		friend class database_type;
+		friend class persistent_type;
+		friend class lazy_type;
+		friend class type_table;
+		friend class pattern_set;
+		friend class type_universe;
+	
+	public:
+		
+		using iterator = layer_list::iterator;
+		using const_iterator = layer_list::const_iterator;
+		using reverse_iterator = layer_list::reverse_iterator;
+		using const_reverse_iterator = layer_list::const_reverse_iterator;
+		
+		//! Default Ctor
+		type() : type( allocator_type{} ) {}
+		explicit type( allocator_type alloc ) : layers( alloc ) { layers.emplace_back( layer_type::type , "void" ); }
+		
+		//! Ctor from C++ typename in string form, optionally allocating from a memory resource such as a 'type_arena'
+		type( const char* val , allocator_type alloc = {} ) : layers( alloc ) { if( val ) parse( val ); }
+		type( std::string_view val , allocator_type alloc = {} ) : layers( alloc ) { parse( val ); }
+		type( const std::string& val , allocator_type alloc = {} ) : type( std::string_view( val ) , alloc ) {}
+		type( const type& other , allocator_type alloc = {} ) : layers( other.layers , alloc ) , cached_hash( other.cached_hash.load( std::memory_order_relaxed ) ) {}
+		type( type&& other ) : layers( std::move(other.layers) ) , cached_hash( other.cached_hash.exchange( 0 , std::memory_order_relaxed ) ) {}
+		type( type&& other , allocator_type alloc ) : layers( std::move(other.layers) , alloc ) , cached_hash( other.cached_hash.exchange( 0 , std::memory_order_relaxed ) ) {}
+		type& operator=( const type& other ){
+			layers = other.layers;
+			cached_hash.store( other.cached_hash.load( std::memory_order_relaxed ) , std::memory_order_relaxed );
+			return *this;
+		}
+		type& operator=( type&& other ){
+			layers = std::move(other.layers);
+			cached_hash.store( other.cached_hash.exchange( 0 , std::memory_order_relaxed ) , std::memory_order_relaxed );
+			return *this;
+		}
+		
+		//! Returns the allocator that all layers and arguments of this type are allocated with
+		allocator_type get_allocator() const { return layers.get_allocator(); }
+		
+		//! Comparison operator
+		bool operator==( const type& other ) const {
+			size_t lhs_hash = cached_hash.load( std::memory_order_relaxed );
+			size_t rhs_hash = other.cached_hash.load( std::memory_order_relaxed );
+			if( lhs_hash && rhs_hash && lhs_hash != rhs_hash )
+				return false;
+			return layers == other.layers;
+		}
+		bool operator!=( const type& other ) const { return !( *this == other ); }
+		
+		/**
+		 * Structural hash over all layers (including the parameter types of functions), consistent with operator==.
+		 * It is computed once and cached until this type is modified. Types with function arguments are not cached,
+		 * since their arguments may be modified through the shared pointers without this type noticing.
+		 * Since contents are hashed by their symbol id, hashes are only stable within one process.
+		 */
+		size_t hash() const
+		{
+			size_t result = cached_hash.load( std::memory_order_relaxed );
+			if( result )
+				return result;
+			result = detail::hash_seed;
+			bool has_arguments = false;
+			for( const layer& lr : layers ){
+				result = detail::hash_combine( result , size_t(lr.layer_type) | size_t(lr.is_const) << 3 | size_t(lr.is_volatile) << 4 );
+				result = detail::hash_combine( result , lr.content.id() );
+				for( const auto& arg : lr.arguments )
+					result = detail::hash_combine( result , arg->hash() );
+				has_arguments |= !lr.arguments.empty();
+			}
+			result += !result; // 0 is reserved for 'not computed'
+			if( !has_arguments )
+				cached_hash.store( result , std::memory_order_relaxed );
+			return result;
+		}
+		
+		//! Boolean conversion
+		explicit operator bool() const { return !layers.empty(); }
+		
+		//! Iterator Interface (Mutable access invalidates the cached hash)
+		iterator begin(){ invalidate_hash(); return layers.begin(); }
+		const_iterator begin() const { return layers.begin(); }
+		const_iterator cbegin() const { return layers.cbegin(); }
+		iterator end(){ invalidate_hash(); return layers.end(); }
+		const_iterator end() const { return layers.end(); }
+		const_iterator cend() const { return layers.cend(); }
+		reverse_iterator rbegin(){ invalidate_hash(); return layers.rbegin(); }
+		const_reverse_iterator rbegin() const { return layers.rbegin(); }
+		const_reverse_iterator crbegin() const { return layers.crbegin(); }
+		reverse_iterator rend(){ invalidate_hash(); return layers.rend(); }
+		const_reverse_iterator rend() const { return layers.rend(); }
+		const_reverse_iterator crend() const { return layers.crend(); }
+		
+		//! Convert this structure to a string representation (possibly to declare a variable 'name')
+		std::string to_string( std::string_view name = {} ) const
+		{
+			std::string output;
+			to_string( output , name );
+			return output;
+		}
+		
+		//! Appends the string representation of this type (possibly declaring a variable 'name') to 'output'
+		void to_string( std::string& output , std::string_view name ) const {
+			detail::emitter::write( output , layers , name );
+		}
+		
+		//! Returns the type 'T'. It is only constructed once per 'T', later calls return a (deep) copy
+		template<typename T>
+		static type from_type( allocator_type alloc = {} ){
+			type result( from_type_ref<T>() , alloc );
+			result.unshare_arguments(); // Modifying them must not change the cached instance
+			return result;
+		}
+		
+		//! Returns a reference to the (immutable) type 'T', which is constructed on the first call
+		template<typename T>
+		static const type& from_type_ref(){
+			static const type instance = []{
+				type result( nullptr );
+				from_type_helper<T>::work( result );
+				return result;
+			}();
+			return instance;
+		}
+		
+		//! Decodes an Itanium C++ ABI type encoding (e.g. "PKc", as returned by typeid(T).name() on gcc and clang). Returns an empty type on malformed or unsupported input
+		static type from_mangled( std::string_view mangled , allocator_type alloc = {} );
+		
+		//! Parses the C++ typename 'input' and brings it into its canonical form (see canonicalize())
+		static type parse_canonical( std::string_view input , allocator_type alloc = {} ){
+			type result( input , alloc );
+			result.canonicalize();
+			return result;
+		}
+		
+	public: //! MODIFIERS !//
+		
+		//! Sets the basic data type of this type object
+		void set_datatype( type t ){
+			invalidate_hash();
+			if( !layers.empty() && layers.front().layer_type == layer_type::type )
+				layers.erase( layers.begin() );
+			layers.insert( layers.begin() , t.layers.begin() , t.layers.end() );
+		}
+		//! Adds a 'const' qualification to this type at the outermost level
+		void add_const(){
+			invalidate_hash();
+			if( layers.empty() )
+				layers.emplace_back( layer_type::type , "void" , true );
+			switch( layers.back().layer_type ){
+				case layer_type::type:
+				case layer_type::pointer:
+				case layer_type::member_pointer:
+					layers.back().is_const = true;
+					break;
+				default:
+					break;
+			}
+		}
+		//! Adds a 'volatile' qualification to this type at the outermost level
+		void add_volatile(){
+			invalidate_hash();
+			if( layers.empty() )
+				layers.emplace_back( layer_type::type , "void" , false , true );
+			switch( layers.back().layer_type ){
+				case layer_type::type:
+				case layer_type::pointer:
+				case layer_type::member_pointer:
+					layers.back().is_volatile = true;
+					break;
+				default:
+					break;
+			}
+		}
+		//! Adds a array qualification to this type at the outermost level
+		void add_array( int extent = -1 ){
+			invalidate_hash();
+			if( layers.empty() )
+				layers.emplace_back( layer_type::type , "void" );
+			layers.emplace_back( layer_type::array , extent > 0 ? detail::to_string(extent) : "" );
+		}
+		//! Adds a function qualification to this type at the outermost level
+		void add_function( std::vector<std::shared_ptr<type>> parameters = {} ){
+			invalidate_hash();
+			if( layers.empty() )
+				layers.emplace_back( layer_type::type , "void" );
+			layers.emplace_back( layer_type::function );
+			layers.back().arguments.assign( parameters.begin() , parameters.end() );
+		}
+		//! Removes 'const' qualification of this type at the outermost level
+		void remove_const(){
+			invalidate_hash();
+			if( !layers.empty() )
+				layers.back().is_const = false;
+		}
+		//! Removes 'volatile' qualification of this type at the outermost level
+		void remove_volatile(){
+			invalidate_hash();
+			if( !layers.empty() )
+				layers.back().is_volatile = false;
+		}
+		//! Removes reference qualification of this type at the outermost level
+		void remove_reference(){
+			invalidate_hash();
+			switch( layers.back().layer_type ){
+				case layer_type::lvalue:
+				case layer_type::rvalue:
+					layers.pop_back();
+					break;
+				default:
+					break;
+			}
+		}
+		//! Removes pointer, array or function qualification of this type at the outermost level
+		void remove_pointer(){
+			invalidate_hash();
+			switch( layers.back().layer_type ){
+				case layer_type::pointer:
+				case layer_type::member_pointer:
+				case layer_type::function:
+				case layer_type::array:
+					layers.pop_back();
+					break;
+				default:
+					break;
+			}
+		}
+		//! Resets this type to 'void'
+		void clear(){
+			invalidate_hash();
+			layers.clear();
+			layers.emplace_back( layer_type::type , "void" );
+		}
+		//! Replaces this type by the C++ typename 'input'. Returns whether all of 'input' was read as one valid type
+		bool parse( std::string_view input ){
+			invalidate_hash();
+			detail::parse_stats_scope stats( input );
+			detail::cursor cur( input );
+			layers.clear();
+			bool result = detail::grammar<type>::node_type( *this , cur );
+			detail::grammar<type>::skip_spaces( cur );
+			stats.finish( cur.pos );
+			return result && cur.pos == cur.end;
+		}
+		//! Replaces this type by the C++ typename at the beginning of 'input' (after leading spaces), reading as much as possible.
+		//! Returns the number of bytes up to the end of the typename (excluding trailing spaces), or 0 if 'input' does not start with one
+		size_t parse_prefix( std::string_view input ){
+			invalidate_hash();
+			detail::parse_stats_scope stats( input );
+			detail::cursor cur( input );
+			layers.clear();
+			bool result = detail::grammar<type>::node_type( *this , cur );
+			stats.finish( cur.pos );
+			if( !result )
+				return 0;
+			while( cur.pos != input.data() && detail::is_space( cur.pos[-1] ) )
+				cur.pos--;
+			return cur.pos - input.data();
+		}
+		
+		//! Brings this type into its canonical form, in which all spellings of a type (e.g. "int unsigned" and "unsigned")
+		//! are equal. Canonical names are computed once per distinct name, so equality stays a structural compare of symbols.
+		//! Names with template arguments nested deeper than detail::grammar<type>::max_nesting_depth are left as they are
+		type& canonicalize()
+		{
+			invalidate_hash();
+			for( layer& lr : layers ){
+				lr.content = lr.content.canonical();
+				for( std::shared_ptr<type>& arg : lr.arguments ){
+					if( arg->is_canonical() )
+						continue;
+					type canonical( *arg , get_allocator() ); // Arguments may be shared with other types
+					canonical.canonicalize();
+					arg = std::allocate_shared<type>( lr.arguments.get_allocator() , std::move(canonical) );
+				}
+			}
+			return *this;
+		}
+	public: //! INFORMATION RETRIEVAL !//
+	
+		std::string get_datatype() const {
+			return !layers.empty() && layers.front().layer_type == layer_type::type ? std::string( layers.front().content ) : std::string();
+		}
+		bool is_plain() const {
+			return layers.size() == 1 && layers.front().layer_type == layer_type::type;
+		}
+		bool is_lvalue_reference() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::lvalue;
+		}
+		bool is_rvalue_reference() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::rvalue;
+		}
+		bool is_array() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::array;
+		}
+		bool is_pointer() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::pointer;
+		}
+		bool is_member_pointer() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::member_pointer;
+		}
+		bool is_const() const {
+			return !layers.empty() && layers.back().is_const;
+		}
+		bool is_volatile() const {
+			return !layers.empty() && layers.back().is_volatile;
+		}
+		bool is_void() const {
+			return layers.size() == 1 && layers.front().content == "void";
+		}
+		bool is_canonical() const {
+			return std::all_of( layers.begin() , layers.end() , []( const layer& lr ){
+				return
+					lr.content.canonical() == lr.content
+					&& std::all_of( lr.arguments.begin() , lr.arguments.end() , []( const std::shared_ptr<type>& arg ){ return arg->is_canonical(); } )
+				;
+			});
+		}
+		
+		//! Returns the template arguments of the basic data type (e.g. 'int' and 'long' for "std::pair<int,long>*").
+		//! They are parsed on the first request and shared by all types with the same basic data type
+		const template_argument_list& template_arguments() const {
+			return ( !layers.empty() && layers.front().layer_type == layer_type::type ? layers.front().content : symbol() ).template_arguments();
+		}
+		
+	private:
+		
+		void invalidate_hash(){ cached_hash.store( 0 , std::memory_order_relaxed ); }
+		
+		//! Replaces all (possibly shared) function arguments by copies of their own, recursively
+		void unshare_arguments(){
+			for( layer& lr : layers )
+				for( auto& arg : lr.arguments ){
+					arg = std::allocate_shared<type>( lr.arguments.get_allocator() , *arg );
+					arg->unshare_arguments();
+				}
+		}
+		
+	private: //! PARSER STUFF !//
+		
+		//! Hooks used by detail::grammar to parse the parameters of a function layer
+		type make_argument() const { return type( nullptr , get_allocator() ); }
+		static void add_argument( layer& lr , type&& arg ){
+			detail::count( &parse_stats::allocations ); // The argument itself
+			detail::counted_emplace_back( lr.arguments , std::allocate_shared<type>( lr.arguments.get_allocator() , std::move(arg) ) );
+		}
+		
+	private:
+		
+		template<typename T, bool = std::is_reference<T>::value || std::is_array<T>::value || std::is_pointer<T>::value>
+		struct from_type_helper{ static void work( type& dest ){
+			dest.layers.emplace_back( layer_type::type , detail::get_typename<T>() );
+		} };
+		template<typename T>
+		struct from_type_helper<const T,false>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.back().is_const = true;
+		} };
+		template<typename T>
+		struct from_type_helper<volatile T,false>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.back().is_volatile = true;
+		} };
+		template<typename T, bool B>
+		struct from_type_helper<T*,B>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.emplace_back( layer_type::pointer );
+		} };
+		template<typename T, bool B>
+		struct from_type_helper<T&,B>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.emplace_back( layer_type::lvalue );
+		} };
+		template<typename T, bool B>
+		struct from_type_helper<T&&,B>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.emplace_back( layer_type::rvalue );
+		} };
+		template<typename T, bool B>
+		struct from_type_helper<T[],B>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.emplace_back( layer_type::array );
+		} };
+		template<typename T, size_t N, bool B>
+		struct from_type_helper<T[N],B>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.emplace_back( layer_type::array , detail::to_string(N) );
+		} };
+		template<typename T, class C, bool B>
+		struct from_type_helper<T (C::*),B>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.emplace_back( layer_type::member_pointer , detail::get_typename<C>() );
+		} };
+		template<typename T, typename... A, bool B>
+		struct from_type_helper<T(A...),B>{ static void work( type& dest ){
+			from_type_helper<T>::work( dest );
+			dest.layers.emplace_back( layer_type::function );
+			detail::variadic_comma_type dummy{ (dest.layers.back().arguments.emplace_back( std::allocate_shared<type>( dest.get_allocator() , type::from_type<A>( dest.get_allocator() ) ) ), 0)... };
+		} };
+	};
+	
+	// Up to 4 layers of 16 bytes, their count and capacity, the allocator and the cached hash
+	static_assert( sizeof(type) <= 4 * ( 8 + sizeof(void*) ) + 8 + sizeof(void*) + sizeof(size_t) , "type stores up to 4 layers inline" );
+	
+	/**
+	 * Read-only, non-owning counterpart of 'type': The contents of all layers refer directly to the parsed
+	 * input (which therefore has to outlive the view), so parsing performs no string copies.
+	 * Only contents, that do not appear contiguously in the input (e.g. "unsigned int" read from
+	 * "unsigned const int"), are interned in the global symbol_table.
+	 * Use to_owned() to obtain a modifiable 'type'.
+	 */
+	class type_view
+	{
+	private:
+		
+		struct layer
+		{
+			parser::layer_type					layer_type;
+			std::string_view					content;
+			bool 								is_const = false;
+			bool 								is_volatile = false;
+			std::vector<type_view>				arguments;
+			
+			layer( parser::layer_type layer_type = parser::layer_type::type ) : layer_type( layer_type ) {}
+			
+			bool operator==( const layer& other ) const {
+				return
+					layer_type == other.layer_type
+					&& is_const == other.is_const
+					&& is_volatile == other.is_volatile
+					&& content == other.content
+					&& arguments == other.arguments
+				;
+			}
+			bool operator!=( const layer& other ) const { return !( *this == other ); }
+		};
+		
+		using layer_list = std::vector<layer>;
+		
+		layer_list layers;
+		
+		template<typename> friend struct detail::grammar;
+		
+	public:
+		
+		using iterator = layer_list::const_iterator;
+		using const_iterator = layer_list::const_iterator;
+		using reverse_iterator = layer_list::const_reverse_iterator;
+		using const_reverse_iterator = layer_list::const_reverse_iterator;
+		
+		//! Ctor from C++ typename in string form. 'input' must outlive the view
+		explicit type_view( std::string_view input ){
+			detail::parse_stats_scope stats( input );
+			detail::cursor cur( input );
+			detail::grammar<type_view>::node_type( *this , cur );
+			stats.finish( cur.pos );
+		}
+		
+		//! Comparison operator
+		bool operator==( const type_view& other ) const { return layers == other.layers; }
+		bool operator!=( const type_view& other ) const { return layers != other.layers; }
+		
+		//! Boolean conversion
+		explicit operator bool() const { return !layers.empty(); }
+		
+		//! Iterator Interface
+		const_iterator begin() const { return layers.begin(); }
+		const_iterator cbegin() const { return layers.cbegin(); }
+		const_iterator end() const { return layers.end(); }
+		const_iterator cend() const { return layers.cend(); }
+		const_reverse_iterator rbegin() const { return layers.rbegin(); }
+		const_reverse_iterator crbegin() const { return layers.crbegin(); }
+		const_reverse_iterator rend() const { return layers.rend(); }
+		const_reverse_iterator crend() const { return layers.crend(); }
+		
+		//! Convert this structure to a string representation (possibly to declare a variable 'name')
+		std::string to_string( std::string_view name = {} ) const
+		{
+			std::string output;
+			to_string( output , name );
+			return output;
+		}
+		
+		//! Appends the string representation of this type (possibly declaring a variable 'name') to 'output'
+		void to_string( std::string& output , std::string_view name ) const {
+			detail::emitter::write( output , layers , name );
+		}
+		
+		//! Copies this view into a 'type', optionally allocating from a memory resource such as a 'type_arena'
+		type to_owned( type::allocator_type alloc = {} ) const
+		{
+			type result( nullptr , alloc );
+			result.layers.reserve( layers.size() );
+			for( const layer& lr : layers ){
+				result.layers.emplace_back( lr.layer_type , lr.content , lr.is_const , lr.is_volatile );
+				for( const type_view& arg : lr.arguments )
+					result.layers.back().arguments.push_back( std::allocate_shared<type>( alloc , arg.to_owned( alloc ) ) );
+			}
+			return result;
+		}
+		
+	public: //! INFORMATION RETRIEVAL !//
+		
+		std::string_view get_datatype() const {
+			return !layers.empty() && layers.front().layer_type == layer_type::type ? layers.front().content : std::string_view();
+		}
+		bool is_plain() const {
+			return layers.size() == 1 && layers.front().layer_type == layer_type::type;
+		}
+		bool is_lvalue_reference() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::lvalue;
+		}
+		bool is_rvalue_reference() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::rvalue;
+		}
+		bool is_array() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::array;
+		}
+		bool is_pointer() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::pointer;
+		}
+		bool is_member_pointer() const {
+			return !layers.empty() && layers.back().layer_type == layer_type::member_pointer;
+		}
+		bool is_const() const {
+			return !layers.empty() && layers.back().is_const;
+		}
+		bool is_volatile() const {
+			return !layers.empty() && layers.back().is_volatile;
+		}
+		bool is_void() const {
+			return layers.size() == 1 && layers.front().content == "void";
+		}
+		
+	private: //! PARSER STUFF !//
+		
+		//! Hooks used by detail::grammar to parse the parameters of a function layer
+		type_view make_argument() const { return type_view(); }
+		static void add_argument( layer& lr , type_view&& arg ){ detail::counted_emplace_back( lr.arguments , std::move(arg) ); }
+		
+		type_view() = default;
+	};
+	
+	namespace detail
+	{
+		//! Checks, whether the template argument 'text' may be a type (as opposed to literals, operators and the like)
+		inline bool is_type_argument( std::string_view text )
+		{
+			static constexpr std::string_view expression_keywords[] = { "true" , "false" , "nullptr" , "sizeof" , "alignof" , "noexcept" , "decltype" };
+			
+			if( !is_identifier_start( text.front() ) && text.front() != ':' )
+				return false;
+			for( std::string_view keyword : expression_keywords )
+				if( text.substr( 0 , keyword.size() ) == keyword && ( text.size() == keyword.size() || !is_identifier_char( text[keyword.size()] ) ) )
+					return false;
+			return true;
+		}
+		
+		//! Reads one template argument: Either a type or a constant expression
+		inline template_argument make_template_argument( std::string_view text )
+		{
+			if( is_type_argument( text ) ){
+				type result( nullptr );
+				if( result.parse( text ) )
+					return { std::make_shared<const type>( std::move(result) ) , {} };
+			}
+			return { nullptr , symbol( text ) };
+		}
+		
+		/**
+		 * Calls 'fn' with every (trimmed, non-empty) template argument between the '<' at 'open' and the matching '>' at 'close'.
+		 * Arguments are separated by commas outside of nested angle brackets, parentheses, brackets and braces.
+		 */
+		template<typename Function>
+		void for_each_template_argument( const char* open , const char* close , Function&& fn )
+		{
+			int num_open_angles = 0;
+			int num_open_parens = 0;
+			const char* argument_begin = open + 1;
+			for( const char* pos = open + 1 ; pos <= close ; pos++ ){
+				if( pos != close ){
+					switch( *pos ){
+						case '(': case '[': case '{':
+							num_open_parens++;
+							continue;
+						case ')': case ']': case '}':
+							num_open_parens--;
+							continue;
+						case '<':
+							num_open_angles += !num_open_parens;
+							continue;
+						case '>':
+							num_open_angles -= !num_open_parens;
+							continue;
+						case ',':
+							if( num_open_parens || num_open_angles )
+								continue;
+							break;
+						default:
+							continue;
+					}
+				}
+				
+				const char* argument_end = pos;
+				while( argument_begin != argument_end && is_space( *argument_begin ) )
+					argument_begin++;
+				while( argument_begin != argument_end && is_space( argument_end[-1] ) )
+					argument_end--;
+				if( argument_begin != argument_end )
+					fn( std::string_view( argument_begin , argument_end - argument_begin ) );
+				argument_begin = pos + 1;
+			}
+		}
+		
+		//! Returns the '<' of the template-id at the end of 'name' or nullptr, if 'name' does not end with one
+		inline const char* find_final_template_id( std::string_view name )
+		{
+			if( name.empty() || name.back() != '>' )
+				return nullptr;
+			
+			// Find the candidate from the back, then verify it from the front
+			const char* begin = name.data();
+			const char* end = name.data() + name.size();
+			int num_open_angles = 0;
+			int num_open_parens = 0;
+			for( const char* pos = end ; pos-- != begin ; ){
+				switch( *pos ){
+					case ')': case ']': case '}':
+						num_open_parens++;
+						break;
+					case '(': case '[': case '{':
+						num_open_parens--;
+						break;
+					case '>':
+						num_open_angles += !num_open_parens;
+						break;
+					case '<':
+						if( !num_open_parens && --num_open_angles == 0 )
+							return find_matching_angle_bracket( pos , end ) == end - 1 ? pos : nullptr;
+						break;
+				}
+			}
+			return nullptr;
+		}
+		
+		//! Splits the template arguments of the last component of 'name' (if it is a template-id)
+		inline template_argument_list parse_template_arguments( std::string_view name )
+		{
+			template_argument_list result;
+			if( const char* open = find_final_template_id( name ) )
+				for_each_template_argument( open , name.data() + name.size() - 1 , [&result]( std::string_view argument ){
+					result.push_back( make_template_argument( argument ) );
+				});
+			return result;
+		}
+		
+		//! Returns the canonical spelling of the primitive type 'name' (e.g. "unsigned int" for "int unsigned"), or an empty string if 'name' is none
+		inline std::string_view canonical_primitive( std::string_view name )
+		{
+			static constexpr std::string_view integers[2][4] = {
+				{ "int" , "short" , "long" , "long long" }
+				, { "unsigned int" , "unsigned short" , "unsigned long" , "unsigned long long" }
+			};
+			
+			int num_signed = 0 , num_unsigned = 0 , num_short = 0 , num_long = 0;
+			std::string_view base; // Keyword other than 'int' and the modifiers above
+			
+			for( size_t pos = 0 ; pos < name.size() ; ){
+				size_t word_end = std::min( name.find( ' ' , pos ) , name.size() );
+				std::string_view word = name.substr( pos , word_end - pos );
+				pos = word_end + 1;
+				if( word.empty() )
+					continue;
+				else if( word == "signed" )
+					num_signed++;
+				else if( word == "unsigned" )
+					num_unsigned++;
+				else if( word == "short" )
+					num_short++;
+				else if( word == "long" )
+					num_long++;
+				else if( word == "int" )
+					continue;
+				else if( !symbol_table::find_primitive( word ) || !base.empty() )
+					return {};
+				else
+					base = word;
+			}
+			
+			if( base == "char" )
+				return num_unsigned ? "unsigned char" : num_signed ? "signed char" : "char";
+			if( base == "double" && num_long )
+				return "long double";
+			if( !base.empty() )
+				return base;
+			return integers[num_unsigned > 0][num_short ? 1 : std::min( num_long , 2 ) + ( num_long > 0 )];
+		}
+		
+		//! Nesting of names currently canonicalized by append_canonical_name() on this thread
+		struct canonical_nesting
+		{
+			static inline thread_local int		depth = 0;
+			static inline thread_local bool	exceeded = false; // Set once 'depth' exceeded grammar<type>::max_nesting_depth, reset by the outermost name
+			
+			canonical_nesting(){ depth++; }
+			~canonical_nesting(){ depth--; }
+			canonical_nesting( const canonical_nesting& ) = delete;
+			
+			explicit operator bool() const {
+				if( depth > grammar<type>::max_nesting_depth )
+					exceeded = true;
+				return !exceeded;
+			}
+		};
+		
+		/**
+		 * Checks, whether the type argument 'text' is a plain (qualified) name like "std::vector<int>::iterator", which is its own
+		 * type and can be canonicalized by append_canonical_name() directly instead of being parsed (and interned) first
+		 */
+		inline bool is_plain_name( std::string_view text )
+		{
+			const char* pos = text.data();
+			const char* end = text.data() + text.size();
+			if( end - pos >= 2 && pos[0] == ':' && pos[1] == ':' )
+				pos += 2;
+			while( pos != end && is_identifier_start( *pos ) ){
+				const char* word_end = skip_identifier( pos + 1 , end );
+				std::string_view word( pos , word_end - pos );
+				if( symbol_table::find_primitive( word ) || word == "const" || word == "volatile" || word == "typename"
+					|| word == "class" || word == "struct" || word == "enum" || word == "union" )
+					return false;
+				pos = word_end;
+				if( pos != end && *pos == '<' && ( pos = find_matching_angle_bracket( pos , end ) ) != end )
+					pos++;
+				if( pos == end )
+					return true;
+				if( end - pos < 2 || pos[0] != ':' || pos[1] != ':' )
+					return false;
+				pos += 2;
+			}
+			return false;
+		}
+		
+		/**
+		 * Appends the canonical spelling of the name 'name' to 'output':
+		 * Primitive types are spelled as in canonical_primitive(), a leading '::' is removed, whitespace is only kept between two
+		 * identifiers and template arguments are canonicalized themselves and separated by ", ".
+		 * Returns false, if template arguments are nested deeper than grammar<type>::max_nesting_depth, in which case 'output' is
+		 * incomplete and canonical_nesting::exceeded stays set until the outermost name (see symbol_table::canonical()) clears it.
+		 */
+		inline bool append_canonical_name( std::string& output , std::string_view name )
+		{
+			canonical_nesting nesting;
+			if( !nesting )
+				return false;
+			if( canonical_nesting::depth == 1 ){
+				// Fail at once instead of canonicalizing the outer levels of an obviously too deep name first
+				int num_open_angles = 0;
+				for( char c : name ){
+					if( c == '>' && num_open_angles )
+						num_open_angles--;
+					else if( c == '<' && ++num_open_angles > grammar<type>::max_nesting_depth ){
+						canonical_nesting::exceeded = true;
+						return false;
+					}
+				}
+			}
+			
+			if( std::string_view primitive = canonical_primitive( name ) ; !primitive.empty() ){
+				output += primitive;
+				return true;
+			}
+			
+			size_t		start = output.size();
+			const char*	pos = name.data();
+			const char*	end = name.data() + name.size();
+			
+			while( pos != end && is_space( *pos ) )
+				pos++;
+			if( end - pos >= 2 && pos[0] == ':' && pos[1] == ':' )
+				pos += 2; // Redundant global qualification
+			
+			while( pos != end ){
+				if( is_space( *pos ) ){
+					while( pos != end && is_space( *pos ) )
+						pos++;
+					if( pos != end && output.size() > start && is_identifier_char( output.back() ) && is_identifier_char( *pos ) )
+						output += ' ';
+					continue;
+				}
+				const char* close = *pos == '<' ? find_matching_angle_bracket( pos , end ) : end;
+				if( close == end ){
+					output += *pos++;
+					continue;
+				}
+				
+				output += '<';
+				bool is_first = true;
+				for_each_template_argument( pos , close , [&output, &is_first]( std::string_view argument ){
+					if( canonical_nesting::exceeded )
+						return;
+					if( !is_first )
+						output += ", ";
+					is_first = false;
+					if( is_type_argument( argument ) && !is_plain_name( argument ) ){
+						type argument_type( nullptr );
+						if( argument_type.parse( argument ) ){
+							argument_type.canonicalize().to_string( output , {} );
+							return;
+						}
+					}
+					append_canonical_name( output , argument );
+				});
+				if( canonical_nesting::exceeded )
+					return false;
+				output += '>';
+				pos = close + 1;
+			}
+			return true;
+		}
+		
+		//! Shared (empty) list of template arguments of all names, that are no template-ids
+		inline const template_argument_list no_template_arguments;
+	}
+	
+	inline const template_argument_list& symbol_table::template_arguments( id_type id )
+	{
+		entry& e = entry_at( id , false );
+		const template_argument_list* result = e.template_arguments.load( std::memory_order_acquire );
+		if( result )
+			return *result;
+		
+		// Parse outside of any lock (arguments intern their own names). If another thread was faster, use its list
+		template_argument_list arguments = detail::parse_template_arguments( lookup( id ) );
+		const template_argument_list* desired = arguments.empty() ? &detail::no_template_arguments : new template_argument_list( std::move(arguments) );
+		if( e.template_arguments.compare_exchange_strong( result , desired , std::memory_order_acq_rel , std::memory_order_acquire ) )
+			return *desired;
+		if( desired != &detail::no_template_arguments )
+			delete desired;
+		return *result;
+	}
+	
+	inline symbol_table::id_type symbol_table::canonical( id_type id )
+	{
+		entry& e = entry_at( id , false );
+		id_type result = e.canonical_id.load( std::memory_order_acquire );
+		if( result != unknown_id )
+			return result;
+		
+		std::string name; // Not the scratch buffer, which is used by the parser of nested template arguments
+		bool is_outermost = !detail::canonical_nesting::depth;
+		if( is_outermost )
+			detail::canonical_nesting::exceeded = false;
+		if( !detail::append_canonical_name( name , lookup( id ) ) ){
+			// Nested too deeply: The outermost name is left as it is, names nested into it are not cached (their own nesting may be fine)
+			if( !is_outermost )
+				return id;
+			detail::canonical_nesting::exceeded = false;
+			e.canonical_id.store( id , std::memory_order_release );
+			return id;
+		}
+		result = intern( name );
+		
+		entry_at( result , false ).canonical_id.store( result , std::memory_order_release ); // Canonical names are canonical
+		e.canonical_id.store( result , std::memory_order_release );
+		return result;
+	}
+	
+	inline symbol_table::~symbol_table()
+	{
+		for( size_t bucket = 0 ; bucket < num_buckets ; bucket++ ){
+			entry* entries = buckets[bucket].load();
+			if( !entries )
+				continue;
+			for( size_t i = 0 ; i < ( size_t(1) << ( bucket + first_bucket_bits ) ) ; i++ ){
+				const template_argument_list* arguments = entries[i].template_arguments.load();
+				if( arguments != &detail::no_template_arguments )
+					delete arguments;
+			}
+			delete[] entries;
+		}
+	}
+	
+	namespace detail
+	{
+		/**
+		 * Decoder of type encodings of the Itanium C++ ABI (as returned by typeid(T).name() on gcc and clang), see type::from_mangled().
+		 * Layers are built directly while reading, only class names (including their template arguments) are assembled as text.
+		 * Substitution candidates are recorded as ranges of the input and decoded again whenever they are referenced.
+		 * Decoding fails beyond grammar<type>::max_nesting_depth nested types or once the input read again by substitutions
+		 * exceeds 'max_replay_factor' times its length, since chains of substitutions may expand exponentially.
+		 *
+		 * GRAMMAR (supported subset):
+		 *
+		 * <type>				:= <builtin_type> | <qualified_type> | <name> | <substitution> [ <template_args> ]
+		 *						 | 'P' <type> | 'R' <type> | 'O' <type> | <function_type> | <array_type> | <member_pointer_type>
+		 * <qualified_type>		:= [ 'r' ] [ 'V' ] [ 'K' ] <type>
+		 * <function_type>		:= 'F' [ 'Y' ] <type> { <type> } [ 'R' | 'O' ] 'E'
+		 * <array_type>			:= 'A' [ NUMBER ] '_' <type>
+		 * <member_pointer_type>:= 'M' <type> <type>
+		 * <name>				:= 'N' <prefix> 'E' | [ 'St' ] <source_name> [ <template_args> ]
+		 * <prefix>				:= { <substitution> | 'St' | <source_name> | <template_args> }
+		 * <source_name>		:= NUMBER IDENTIFIER { 'B' NUMBER IDENTIFIER }
+		 * <template_args>		:= 'I' { <template_arg> } 'E'
+		 * <template_arg>		:= <type> | 'L' <type> [ 'n' ] NUMBER 'E' | 'J' { <template_arg> } 'E'
+		 * <substitution>		:= 'S' [ SEQUENCE_ID ] '_' | 'Sa' | 'Sb' | 'Ss' | 'Si' | 'So' | 'Sd'
+		 */
+		class mangled_decoder
+		{
+		private:
+			
+			struct substitution
+			{
+				const char*	begin;
+				const char*	end;
+				bool		is_prefix; // Whether the range is a <prefix> (i.e. a name only), rather than a <type>
+			};
+			
+			//! Buffers that are reused by all decoders of a thread
+			struct workspace
+			{
+				std::vector<substitution>	substitutions;
+				std::deque<type>			types; // Temporaries, used as stack
+				std::deque<std::string>		names; // Temporaries, used as stack
+			};
+			
+			static workspace& get_workspace(){
+				static thread_local workspace instance;
+				return instance;
+			}
+			
+			//! Increments 'depth' for the lifetime of the object, converts to false beyond the maximum nesting depth
+			struct nesting
+			{
+				int& depth;
+				explicit nesting( int& depth ) : depth( ++depth ) {}
+				~nesting(){ depth--; }
+				explicit operator bool() const { return depth <= grammar<type>::max_nesting_depth; }
+			};
+			
+			cursor		input;
+			workspace&	ws = get_workspace();
+			size_t		num_types = 0; // Number of temporaries in use
+			size_t		num_names = 0;
+			int			replaying = 0; // No candidates are recorded while a substitution is decoded again
+			int			depth = 0; // Number of nested types, template arguments and substitutions being decoded
+			size_t		replay_budget; // Number of bytes, that may still be read again by substitutions
+			
+		public:
+			
+			//! Bytes read again by substitutions, in multiples of the length of the input (plus a minimum for short input)
+			static constexpr size_t max_replay_factor = 64;
+			
+			mangled_decoder( std::string_view mangled ) : input( mangled ) , replay_budget( max_replay_factor * ( mangled.size() + 64 ) ) {
+				ws.substitutions.clear();
+			}
+			
+			//! Decodes the whole input into 'dest', returns false on malformed or unsupported input
+			bool decode( type& dest ){
+				return decode_type( dest ) && input.pos == input.end;
+			}
+			
+		private:
+			
+			// Temporaries are released in reverse order of acquisition. They are not released on failure, since decoding is aborted then
+			type& acquire_type(){
+				if( num_types == ws.types.size() )
+					ws.types.emplace_back( nullptr );
+				type& result = ws.types[num_types++];
+				result.layers.clear();
+				return result;
+			}
+			std::string& acquire_name(){
+				if( num_names == ws.names.size() )
+					ws.names.emplace_back();
+				std::string& result = ws.names[num_names++];
+				result.clear();
+				return result;
+			}
+			
+			void add_substitution( const char* begin , bool is_prefix ){
+				if( !replaying )
+					ws.substitutions.push_back( { begin , input.pos , is_prefix } );
+			}
+			
+			//! <type>, appended to the (empty) type 'dest'
+			bool decode_type( type& dest )
+			{
+				const char*	begin = input.pos;
+				nesting		guard( depth );
+				if( !guard )
+					return false;
+				
+				switch( *input )
+				{
+					case 'P': case 'R': case 'O':
+					{
+						char c = *input;
+						input++;
+						if( !decode_type( dest ) )
+							return false;
+						dest.layers.emplace_back( c == 'P' ? layer_type::pointer : c == 'R' ? layer_type::lvalue : layer_type::rvalue );
+						break;
+					}
+					case 'r': case 'V': case 'K':
+					{
+						bool is_volatile = false , is_const = false;
+						if( *input == 'r' ) // 'restrict' is not representable
+							input++;
+						if( *input == 'V' ){
+							is_volatile = true;
+							input++;
+						}
+						if( *input == 'K' ){
+							is_const = true;
+							input++;
+						}
+						if( !decode_type( dest ) )
+							return false;
+						// Qualifications of an array apply to its elements
+						auto qualified = std::find_if( dest.layers.rbegin() , dest.layers.rend() , []( const type::layer& lr ){ return lr.layer_type != layer_type::array; } );
+						qualified->is_const |= is_const;
+						qualified->is_volatile |= is_volatile;
+						break;
+					}
+					case 'F':
+					{
+						input++;
+						if( *input == 'Y' ) // extern "C"
+							input++;
+						if( !decode_type( dest ) ) // Return type
+							return false;
+						dest.layers.emplace_back( layer_type::function );
+						if( input[0] == 'v' && input[1] == 'E' ) // No parameters
+							input++;
+						while( *input && *input != 'E' && !( ( *input == 'R' || *input == 'O' ) && input[1] == 'E' ) ){
+							type param( nullptr , dest.get_allocator() );
+							if( !decode_type( param ) )
+								return false;
+							dest.layers.back().arguments.push_back( std::allocate_shared<type>( dest.get_allocator() , std::move(param) ) );
+						}
+						if( *input == 'R' || *input == 'O' ) // Ref-qualifiers are not representable
+							input++;
+						if( *input != 'E' )
+							return false;
+						input++;
+						break;
+					}
+					case 'A':
+					{
+						input++;
+						const char* extent_begin = input.pos;
+						while( *input >= '0' && *input <= '9' )
+							input++;
+						std::string_view extent( extent_begin , input.pos - extent_begin );
+						if( *input != '_' )
+							return false;
+						input++;
+						if( !decode_type( dest ) )
+							return false;
+						dest.layers.emplace_back( layer_type::array , extent );
+						break;
+					}
+					case 'M':
+					{
+						input++;
+						type& class_type = acquire_type();
+						if( !decode_type( class_type ) || !decode_type( dest ) )
+							return false;
+						std::string& name = acquire_name();
+						class_type.to_string( name , {} );
+						dest.layers.emplace_back( layer_type::member_pointer , name );
+						num_types--;
+						num_names--;
+						break;
+					}
+					case 'S':
+						if( input[1] != 't' )
+						{
+							std::string_view	abbreviation;
+							size_t				index;
+							if( !read_substitution( abbreviation , index ) )
+								return false;
+							if( *input != 'I' ) // A substitution is no new candidate
+								return substitution_to_type( abbreviation , index , dest );
+							
+							// Template name followed by template arguments
+							std::string& name = acquire_name();
+							if( !substitution_to_name( abbreviation , index , name ) || !decode_template_args( name ) )
+								return false;
+							dest.layers.emplace_back( layer_type::type , name );
+							num_names--;
+							break;
+						}
+						[[fallthrough]];
+					case 'N':
+					case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+					{
+						std::string& name = acquire_name();
+						if( !decode_name( name ) )
+							return false;
+						dest.layers.emplace_back( layer_type::type , name );
+						num_names--;
+						break;
+					}
+					default:
+						return decode_builtin( dest ); // Builtin types are no candidates
+				}
+				
+				add_substitution( begin , false );
+				return true;
+			}
+			
+			//! <builtin_type>
+			bool decode_builtin( type& dest )
+			{
+				static const char* const names[] = { // Indexed by the character of single character codes
+					"signed char" , "bool" , "char" , "double" , "long double" , "float" , "__float128" , "unsigned char"
+					, "int" , "unsigned int" , nullptr , "long" , "unsigned long" , "__int128" , "unsigned __int128" , nullptr
+					, nullptr , nullptr , "short" , "unsigned short" , nullptr , "void" , "wchar_t" , "long long" , "unsigned long long" , "..."
+				};
+				static const char* const d_names[][2] = { // Codes starting with 'D'
+					{ "i" , "char32_t" } , { "s" , "char16_t" } , { "u" , "char8_t" } , { "n" , "decltype(nullptr)" }
+					, { "a" , "auto" } , { "c" , "decltype(auto)" } , { "d" , "decimal64" } , { "e" , "decimal128" }
+					, { "f" , "decimal32" } , { "h" , "half" }
+				};
+				static const std::vector<symbol> symbols = []{
+					std::vector<symbol> result;
+					for( const char* name : names )
+						result.emplace_back( name ? name : "" );
+					for( const auto& name : d_names )
+						result.emplace_back( name[1] );
+					return result;
+				}();
+				
+				size_t index = 0;
+				if( *input >= 'a' && *input <= 'z' && names[*input - 'a'] ){
+					index = *input - 'a';
+					input++;
+				}
+				else if( *input == 'D' ){
+					for( index = 0 ; index < std::size( d_names ) && input[1] != d_names[index][0][0] ; index++ );
+					if( index == std::size( d_names ) )
+						return false;
+					index += std::size( names );
+					input += 2;
+				}
+				else
+					return false;
+				dest.layers.emplace_back( layer_type::type , symbols[index] );
+				return true;
+			}
+			
+			//! <name>, appended to 'name'
+			bool decode_name( std::string& name )
+			{
+				if( *input == 'N' ){
+					input++; // cv- and ref-qualifiers only occur in encodings of member functions, not in those of types
+					if( !decode_prefix( name ) || *input != 'E' )
+						return false;
+					input++;
+					return true;
+				}
+				
+				const char* begin = input.pos;
+				if( input.starts_with( "St" ) ){
+					name += "std::";
+					input += 2;
+				}
+				if( !decode_source_name( name ) )
+					return false;
+				if( *input == 'I' ){
+					add_substitution( begin , true ); // The template name
+					return decode_template_args( name );
+				}
+				return true;
+			}
+			
+			//! <prefix> up to the terminating 'E' (not read) or the end of input, appended to 'name'
+			bool decode_prefix( std::string& name )
+			{
+				const char* begin = input.pos;
+				while( *input && *input != 'E' )
+				{
+					if( *input == 'I' ){
+						if( !decode_template_args( name ) )
+							return false;
+					}
+					else{
+						if( !name.empty() && name.back() != ':' )
+							name += "::";
+						if( input.starts_with( "St" ) ){
+							name += "std::";
+							input += 2;
+							continue; // 'St' itself is no candidate
+						}
+						if( *input == 'S' ){
+							std::string_view	abbreviation;
+							size_t				index;
+							if( !read_substitution( abbreviation , index ) || !substitution_to_name( abbreviation , index , name ) )
+								return false;
+							continue; // A substitution is no new candidate
+						}
+						if( !decode_source_name( name ) )
+							return false;
+					}
+					if( *input != 'E' ) // The complete name is recorded as type
+						add_substitution( begin , true );
+				}
+				return true;
+			}
+			
+			//! <source_name>, appended to 'name'
+			bool decode_source_name( std::string& name )
+			{
+				if( !decode_identifier( name ) )
+					return false;
+				while( *input == 'B' ){ // ABI tag
+					input++;
+					name += "[abi:";
+					if( !decode_identifier( name ) )
+						return false;
+					name += ']';
+				}
+				return true;
+			}
+			
+			//! NUMBER IDENTIFIER, appended to 'name'
+			bool decode_identifier( std::string& name )
+			{
+				size_t length = 0;
+				if( *input < '0' || *input > '9' )
+					return false;
+				while( *input >= '0' && *input <= '9' )
+					length = length * 10 + ( *input++ - '0' );
+				if( length == 0 || length > size_t( input.end - input.pos ) )
+					return false;
+				name.append( input.pos , length );
+				input += length;
+				return true;
+			}
+			
+			//! <template_args>, appended to 'name'
+			bool decode_template_args( std::string& name )
+			{
+				input++; // Read the 'I'
+				name += '<';
+				if( !decode_template_arg_list( name ) )
+					return false;
+				if( name.back() == '>' )
+					name += ' ';
+				name += '>';
+				return true;
+			}
+			
+			//! { <template_arg> } 'E', appended to 'name' (separated by commas)
+			bool decode_template_arg_list( std::string& name )
+			{
+				for( bool is_first = true ; *input != 'E' ; is_first = false ){
+					if( !*input )
+						return false;
+					if( !is_first )
+						name += ", ";
+					if( !decode_template_arg( name ) )
+						return false;
+				}
+				input++; // Read the 'E'
+				return true;
+			}
+			
+			//! <template_arg>, appended to 'name'
+			bool decode_template_arg( std::string& name )
+			{
+				nesting guard( depth );
+				if( !guard )
+					return false;
+				if( *input == 'J' ){ // Argument pack
+					input++;
+					return decode_template_arg_list( name );
+				}
+				
+				type& arg = acquire_type();
+				if( *input == 'L' ){ // Literal
+					input++;
+					bool is_bool = *input == 'b';
+					if( !decode_type( arg ) )
+						return false;
+					if( *input == 'n' ){
+						name += '-';
+						input++;
+					}
+					const char* value_begin = input.pos;
+					while( *input && *input != 'E' )
+						input++;
+					if( !*input )
+						return false;
+					std::string_view value( value_begin , input.pos - value_begin );
+					if( is_bool )
+						value = value == "0" ? "false" : "true";
+					name += value;
+					input++; // Read the 'E'
+				}
+				else if( decode_type( arg ) )
+					arg.to_string( name , {} );
+				else
+					return false;
+				num_types--;
+				return true;
+			}
+			
+			/**
+			 * Reads a <substitution>. It is either one of the standard abbreviations (returned in 'abbreviation')
+			 * or refers to the candidate at 'index'
+			 */
+			bool read_substitution( std::string_view& abbreviation , size_t& index )
+			{
+				static const char* const abbreviations[][2] = {
+					{ "Sa" , "std::allocator" } , { "Sb" , "std::basic_string" } , { "Ss" , "std::string" }
+					, { "Si" , "std::istream" } , { "So" , "std::ostream" } , { "Sd" , "std::iostream" }
+				};
+				for( const auto& abbr : abbreviations )
+					if( input.starts_with( abbr[0] ) ){
+						input += 2;
+						abbreviation = abbr[1];
+						return true;
+					}
+				
+				input++; // Read the 'S'
+				index = 0;
+				if( *input != '_' ){
+					for( ; *input != '_' ; input++ ){
+						if( *input >= '0' && *input <= '9' )
+							index = index * 36 + ( *input - '0' );
+						else if( *input >= 'A' && *input <= 'Z' )
+							index = index * 36 + ( *input - 'A' + 10 );
+						else
+							return false;
+					}
+					index++;
+				}
+				input++; // Read the '_'
+				return index < ws.substitutions.size();
+			}
+			
+			//! Decodes the range of a substitution candidate again
+			template<typename Function>
+			bool replay( size_t index , Function function ){
+				const substitution&	s = ws.substitutions[index];
+				nesting				guard( depth );
+				if( !guard || size_t( s.end - s.begin ) > replay_budget )
+					return false;
+				replay_budget -= s.end - s.begin;
+				cursor backup = input;
+				input = cursor( std::string_view( s.begin , s.end - s.begin ) );
+				replaying++;
+				bool result = function( s.is_prefix );
+				replaying--;
+				input = backup;
+				return result;
+			}
+			
+			//! Appends the text of a substitution to 'name'
+			bool substitution_to_name( std::string_view abbreviation , size_t index , std::string& name )
+			{
+				if( !abbreviation.empty() ){
+					name += abbreviation;
+					return true;
+				}
+				return replay( index , [&]( bool is_prefix ){
+					if( is_prefix )
+						return decode_prefix( name );
+					type& t = acquire_type();
+					if( !decode_type( t ) )
+						return false;
+					t.to_string( name , {} );
+					num_types--;
+					return true;
+				});
+			}
+			
+			//! Appends the layers of a substitution to the (empty) type 'dest'
+			bool substitution_to_type( std::string_view abbreviation , size_t index , type& dest )
+			{
+				if( !abbreviation.empty() ){
+					dest.layers.emplace_back( layer_type::type , abbreviation );
+					return true;
+				}
+				return replay( index , [&]( bool is_prefix ){
+					if( !is_prefix )
+						return decode_type( dest );
+					std::string& name = acquire_name();
+					if( !decode_prefix( name ) )
+						return false;
+					dest.layers.emplace_back( layer_type::type , name );
+					num_names--;
+					return true;
+				});
+			}
+		};
+	}
+	
+	inline type type::from_mangled( std::string_view mangled , allocator_type alloc ){
+		type result( nullptr , alloc );
+		if( !detail::mangled_decoder( mangled ).decode( result ) )
+			result.layers.clear();
+		return result;
+	}
+	
+	template<size_t N>
+	class static_type;
+	
+	namespace detail
+	{
+		//! Constant expression variant of symbol_table::find_primitive
+		constexpr bool is_primitive_keyword( std::string_view str ){
+			constexpr std::string_view keywords[] = {
+				"char" , "char16_t" , "char32_t" , "wchar_t" , "bool" , "short"
+				, "int" , "long" , "signed" , "unsigned" , "float" , "double" , "void"
+			};
+			for( std::string_view keyword : keywords )
+				if( keyword == str )
+					return true;
+			return false;
+		}
+		
+		template<size_t N>
+		struct static_grammar;
+	}
+	
+	/**
+	 * Parse result of a C++ typename, that can be computed at compile time (using parser::parse_static("const int (*)[4]")).
+	 * All storage is fixed in size: 'N' is the size of the parsed string literal (each layer consumes at least one character).
+	 * Contents and layers of function parameters are kept in pools and referred to by index, so the object can be copied freely.
+	 * Use to_type() to convert it to a 'type'.
+	 */
+	template<size_t N>
+	class static_type
+	{
+	public:
+		
+		struct layer
+		{
+			parser::layer_type	layer_type = parser::layer_type::type;
+			size_t				content_begin = 0; // Offset of the content within the text pool
+			size_t				content_size = 0;
+			bool				is_const = false;
+			bool				is_volatile = false;
+			size_t				first_argument = 0; // Index of the first parameter of a function layer within the argument pool
+			size_t				num_arguments = 0;
+		};
+		
+		//! Contiguous sequence of layers forming a (parameter) type
+		struct range
+		{
+			size_t	first = 0;
+			size_t	size = 0;
+		};
+		
+	private:
+		
+		char	text[N] = {};
+		size_t	text_size = 0;
+		layer	layers[N] = {};
+		size_t	num_layers = 0;
+		range	arguments[N] = {};
+		size_t	num_arguments = 0;
+		range	root;
+		
+		friend struct detail::static_grammar<N>;
+		
+		type to_type( range r , type::allocator_type alloc ) const
+		{
+			type result( nullptr , alloc );
+			result.layers.reserve( r.size );
+			for( const layer& lr : get_layers( r ) ){
+				result.layers.emplace_back( lr.layer_type , content( lr ) , lr.is_const , lr.is_volatile );
+				for( size_t i = 0 ; i < lr.num_arguments ; i++ )
+					result.layers.back().arguments.push_back( std::allocate_shared<type>( alloc , to_type( arguments[lr.first_argument + i] , alloc ) ) );
+			}
+			return result;
+		}
+		
+	public:
+		
+		//! Sequence of layers, as returned by get_layers()
+		struct layer_range
+		{
+			const layer*	first;
+			const layer*	last;
+			
+			constexpr const layer* begin() const { return first; }
+			constexpr const layer* end() const { return last; }
+			constexpr size_t size() const { return last - first; }
+			constexpr const layer& operator[]( size_t index ) const { return first[index]; }
+		};
+		
+		//! Returns the layers of the parsed type (or of a function parameter, if 'r' is given)
+		constexpr layer_range get_layers() const { return get_layers( root ); }
+		constexpr layer_range get_layers( range r ) const { return { layers + r.first , layers + r.first + r.size }; }
+		
+		//! Returns the parameter types of the function layer 'lr'
+		constexpr const range* arguments_begin( const layer& lr ) const { return arguments + lr.first_argument; }
+		constexpr const range* arguments_end( const layer& lr ) const { return arguments + lr.first_argument + lr.num_arguments; }
+		
+		//! Returns the content of the layer 'lr'
+		constexpr std::string_view content( const layer& lr ) const { return { text + lr.content_begin , lr.content_size }; }
+		
+		//! Iterator Interface
+		constexpr const layer* begin() const { return get_layers().begin(); }
+		constexpr const layer* end() const { return get_layers().end(); }
+		
+		//! Converts this type to its runtime representation
+		type to_type( type::allocator_type alloc = {} ) const { return to_type( root , alloc ); }
+		operator type() const { return to_type(); }
+		
+	public: //! INFORMATION RETRIEVAL !//
+		
+		constexpr std::string_view get_datatype() const {
+			return root.size && layers[root.first].layer_type == layer_type::type ? content( layers[root.first] ) : std::string_view();
+		}
+		constexpr bool is_plain() const {
+			return root.size == 1 && layers[root.first].layer_type == layer_type::type;
+		}
+		constexpr bool is_lvalue_reference() const {
+			return root.size && outermost().layer_type == layer_type::lvalue;
+		}
+		constexpr bool is_rvalue_reference() const {
+			return root.size && outermost().layer_type == layer_type::rvalue;
+		}
+		constexpr bool is_array() const {
+			return root.size && outermost().layer_type == layer_type::array;
+		}
+		constexpr bool is_pointer() const {
+			return root.size && outermost().layer_type == layer_type::pointer;
+		}
+		constexpr bool is_member_pointer() const {
+			return root.size && outermost().layer_type == layer_type::member_pointer;
+		}
+		constexpr bool is_function() const {
+			return root.size && outermost().layer_type == layer_type::function;
+		}
+		constexpr bool is_const() const {
+			return root.size && outermost().is_const;
+		}
+		constexpr bool is_volatile() const {
+			return root.size && outermost().is_volatile;
+		}
+		constexpr bool is_void() const {
+			return root.size == 1 && content( layers[root.first] ) == "void";
+		}
+		
+	private:
+		
+		constexpr const layer& outermost() const { return layers[root.first + root.size - 1]; }
+	};
+	
+	namespace detail
+	{
+		/**
+		 * Constant expression implementation of detail::grammar (see there for the grammar), filling a static_type.
+		 * Since the layers of a type are reordered while reading its declarator, every type (and function parameter)
+		 * is assembled in a local frame and only committed to the layer pool of the result once complete.
 		 */
-		bool node_basic_type( const char*& input )
+		template<size_t N>
+		struct static_grammar
 		{
-			const char* input_backup;
-			std::string content;
-			bool		primitive = true;
+			using layer = typename static_type<N>::layer;
+			using range = typename static_type<N>::range;
 			
-		read_word:
+			struct frame
+			{
+				layer	layers[N] = {};
+				size_t	size = 0;
+				
+				constexpr layer& back(){ return layers[size - 1]; }
+				constexpr void push( parser::layer_type layer_type ){
+					if( size == N )
+						throw std::length_error( "parser::static_type: capacity exceeded" );
+					layers[size++] = layer{ layer_type };
+				}
+			};
 			
-			while( node_cv_qual( input ) );
+			//! Sizes of the pools of the result, to undo speculative reads
+			struct snapshot
+			{
+				size_t	text_size;
+				size_t	num_layers;
+				size_t	num_arguments;
+			};
 			
-			input_backup = input;
+			static_type<N>&	result;
+			cursor			input;
 			
-			if( node_name( input , content ) )
-			{
-				// If the type is primitive, the type is allowed to consist of more than one word
-				bool still_primitive = primitive && is_primitive_type(content);
-				
-				if( !layers.back().content.empty() && still_primitive )
-					layers.back().content += ' ';
-				
-				if( layers.back().content.empty() || still_primitive ){
-					layers.back().content += content;
-					content.clear();
-					primitive = still_primitive;
-					goto read_word;
+			constexpr snapshot save() const { return { result.text_size , result.num_layers , result.num_arguments }; }
+			constexpr void restore( const snapshot& s ){
+				result.text_size = s.text_size;
+				result.num_layers = s.num_layers;
+				result.num_arguments = s.num_arguments;
+			}
+			
+			constexpr void append( const char* first , const char* last ){
+				if( size_t( last - first ) > N - result.text_size )
+					throw std::length_error( "parser::static_type: capacity exceeded" );
+				while( first != last )
+					result.text[result.text_size++] = *first++;
+			}
+			constexpr std::string_view text( size_t begin ) const {
+				return { result.text + begin , result.text_size - begin };
+			}
+			
+			//! Moves the completed type in 'f' to the layer pool of the result
+			constexpr range commit( const frame& f ){
+				if( f.size > N - result.num_layers )
+					throw std::length_error( "parser::static_type: capacity exceeded" );
+				range r{ result.num_layers , f.size };
+				for( size_t i = 0 ; i < f.size ; i++ )
+					result.layers[result.num_layers++] = f.layers[i];
+				return r;
+			}
+			
+			static constexpr void reverse( layer* first , layer* last ){
+				while( first != last && first != --last ){
+					layer tmp = *first;
+					*first++ = *last;
+					*last = tmp;
 				}
-				input = input_backup;
 			}
-			else if( // A Class in global scope!
-				( !primitive || layers.back().content.empty() )
-				&& input[0] == ':'
-				&& input[1] == ':'
-				&& ( std::isalpha(input[2]) || input[2] == '_' )
-			){
-				layers.back().content += "::";
-				input += 2; // Read the '::'
-				node_name( input , layers.back().content );
-				goto read_word;
+			
+			constexpr void skip_spaces(){
+				while( is_space( *input ) )
+					input++;
 			}
 			
-			return !layers.back().content.empty();
-		}
-		
-		//! <node_name>			:= [a-zA-Z_]+ [ '<' TEMPLATE_PARAMETERS '>' ]
-		bool node_name( const char*& input , std::string& dest )
-		{
-			if( !std::isalpha(*input) && *input != '_' )
-				return false;
+			//! Parses the whole input as one type
+			constexpr void parse(){
+				frame f;
+				if( !node_type( f , 0 ) )
+					throw std::invalid_argument( "parser::parse_static: invalid type" );
+				skip_spaces();
+				if( input.pos != input.end )
+					throw std::invalid_argument( "parser::parse_static: unexpected characters after type" );
+				result.root = commit( f );
+			}
 			
-			do{
-				dest += *input++;
-			}while( std::isalpha(*input) || *input == '_' );
+			//! <node_type>
+			constexpr bool node_type( frame& f , int depth ){
+				f.push( layer_type::type );
+				skip_spaces();
+				if( !node_basic_type( f ) ){
+					f.size--;
+					return false;
+				}
+				node_type_qual( f , depth );
+				return true;
+			}
 			
-			skip_spaces( input );
+			//! <node_basic_type>
+			constexpr bool node_basic_type( frame& f )
+			{
+				cursor	input_backup = input;
+				size_t	content_begin = result.text_size;
+				bool	primitive = true;
+				
+				while( true )
+				{
+					while( node_cv_qual( f ) );
+					
+					input_backup = input;
+					size_t content_length = result.text_size - content_begin;
+					
+					if( content_length > 0 && ( !primitive || !is_identifier_start( *input ) ) )
+						; // Only primitive types consist of multiple words
+					else if( content_length > 0 )
+					{
+						const char space = ' ';
+						append( &space , &space + 1 );
+						node_name();
+						
+						// If the type is primitive, the type is allowed to consist of more than one word
+						if( is_primitive_keyword( text( content_begin + content_length + 1 ) ) )
+							continue;
+						
+						result.text_size = content_begin + content_length;
+						input = input_backup;
+					}
+					else if( node_name() ){
+						primitive = is_primitive_keyword( text( content_begin ) );
+						continue;
+					}
+					
+					if( // A Class in global scope!
+						( !primitive || result.text_size == content_begin )
+						&& input[0] == ':'
+						&& input[1] == ':'
+						&& is_identifier_start( input[2] )
+					){
+						append( input.pos , input.pos + 2 );
+						input += 2; // Read the '::'
+						node_name();
+						primitive = false;
+						continue;
+					}
+					break;
+				}
+				
+				if( result.text_size == content_begin )
+					return false;
+				f.back().content_begin = content_begin;
+				f.back().content_size = result.text_size - content_begin;
+				return true;
+			}
 			
-			if( *input == '<' )
+			//! <node_name>
+			constexpr bool node_name()
 			{
-				size_t		orig_len = dest.length();
-				const char* input_backup = input;
-				int			num_open_brackets = 0;
+				if( !is_identifier_start( *input ) )
+					return false;
 				
-				dest += *input++; // Read in the '<'
+				const char* name_begin = input.pos;
+				do{
+					input++;
+				}while( is_identifier_char( *input ) );
+				append( name_begin , input.pos );
+				
+				skip_spaces();
 				
-				while( *input && ( *input != '>' || num_open_brackets > 0 ) ){
-					if( *input == '<' )
-						num_open_brackets++;
-					else if( *input == '>' )
-						num_open_brackets--;
-					dest += *input++;
+				if( *input == '<' )
+				{
+					const char* close = match_angle_bracket( input.pos , input.end );
+					
+					// Check Postconditions
+					if( close != input.end ){
+						append( input.pos , close + 1 );
+						input.pos = close + 1; // Read the '>'
+						skip_spaces();
+					}
 				}
 				
-				// Check Postconditions
-				if( !*input ){
-					dest.resize( orig_len );
-					input = input_backup;
+				return true;
+			}
+			
+			//! <node_cv_qual>
+			constexpr bool node_cv_qual( frame& f ){
+				if( input.starts_with( "const" ) ){
+					input += 5;
+					f.back().is_const = true;
 				}
-				else{
-					dest += input++; // Read the '>'
-					skip_spaces( input );
+				else if( input.starts_with( "volatile" ) ){
+					input += 8;
+					f.back().is_volatile = true;
 				}
+				else
+					return false;
+				skip_spaces();
+				return true;
 			}
 			
-			return true;
-		}
-		
-		//! <node_cv_qual>		:= 'const' | 'volatile'
-		bool node_cv_qual( const char*& input ){
-			if( strncmp( input , "const" , 5 ) == 0 ){
-				input += 5;
-				layers.back().is_const = true;
-			}
-			else if( strncmp( input , "volatile" , 8 ) == 0 ){
-				input += 8;
-				layers.back().is_volatile = true;
-			}
-			else
-				return false;
-			skip_spaces( input );
-			return true;
-		}
-		
-		//! <node_type_qual>		:= <node_ptr_or_ref> [ <node_type_qual> ] | <node_array_func>
-		bool node_type_qual( const char*& input ){
-			if( !node_ptr_or_ref( input ) )
-				return node_array_func( input );
-			while( node_ptr_or_ref( input ) );
-			node_array_func( input );
-			return true;
-		}
-		
-		//! <node_ptr_or_ref>	:= '*' { <node_cv_qual> } | '&' | '&&' | <node_mem_ptr>
-		bool node_ptr_or_ref( const char*& input ){
-			if( *input == '*' ){
-				layers.push_back( { layer_type::pointer } ); // <node_ptr_or_ref>.1
-				input++;
-				skip_spaces( input );
-				while( node_cv_qual( input ) );
+			//! <node_type_qual>
+			constexpr bool node_type_qual( frame& f , int depth ){
+				if( !node_ptr_or_ref( f ) )
+					return node_array_func( f , depth );
+				while( node_ptr_or_ref( f ) );
+				node_array_func( f , depth );
 				return true;
 			}
-			if( *input == '&' ){
-				if( input[1] == '&' ){
-					layers.push_back( { layer_type::rvalue } ); // <node_ptr_or_ref>.3
+			
+			//! <node_ptr_or_ref>
+			constexpr bool node_ptr_or_ref( frame& f ){
+				if( *input == '*' ){
+					f.push( layer_type::pointer );
 					input++;
+					skip_spaces();
+					while( node_cv_qual( f ) );
+					return true;
 				}
-				else
-					layers.push_back( { layer_type::lvalue } ); // <node_ptr_or_ref>.2
-				input++;
-				skip_spaces( input );
-				return true;
+				if( *input == '&' ){
+					if( input[1] == '&' ){
+						f.push( layer_type::rvalue );
+						input++;
+					}
+					else
+						f.push( layer_type::lvalue );
+					input++;
+					skip_spaces();
+					return true;
+				}
+				return node_mem_ptr( f );
 			}
-			if( node_mem_ptr( input ) )
-				return true;
-			return false;
-		}
-		
-		//! <node_mem_ptr>		:= ['::'] <node_name> '::' { <node_name> '::' } '*' { <node_cv_qual> }
-		bool node_mem_ptr( const char*& input )
-		{
-			const char* backup = input;
-			std::string content;
 			
-		start:
-			if( input[0] == ':' && input[1] == ':' ){
-				input+=2;
-				content += "::";
-				skip_spaces( input );
-				goto start;
+			//! <node_mem_ptr>
+			constexpr bool node_mem_ptr( frame& f )
+			{
+				cursor	backup = input;
+				size_t	content_begin = result.text_size;
+				
+				while( true ){
+					if( input[0] == ':' && input[1] == ':' ){
+						append( input.pos , input.pos + 2 );
+						input += 2;
+						skip_spaces();
+					}
+					else if( !node_name() )
+						break;
+				}
+				
+				if( result.text_size == content_begin || result.text[result.text_size - 1] != ':' || *input != '*' ){ // Backtrace
+					input = backup;
+					result.text_size = content_begin;
+					return false;
+				}
+				
+				input++; // Read in the '*'
+				skip_spaces();
+				
+				f.push( layer_type::member_pointer );
+				f.back().content_begin = content_begin;
+				f.back().content_size = result.text_size - content_begin - 2; // Without the trailing '::'
+				
+				while( node_cv_qual( f ) );
+				
+				return true;
 			}
-			else if( node_name( input , content ) )
-				goto start;
 			
-			if( content.empty() || content.back() != ':' || *input != '*' ){ // Backtrace
-				input = backup;
-				return false;
+			//! See grammar::starts_declarator()
+			constexpr bool starts_declarator( frame& f ){
+				if( *input == '*' || *input == '&' || *input == '(' || *input == '[' )
+					return true;
+				cursor		input_backup = input;
+				snapshot	pools_backup = save();
+				size_t		num_layers = f.size;
+				bool		result = node_mem_ptr( f );
+				input = input_backup;
+				restore( pools_backup );
+				f.size = num_layers;
+				return result;
 			}
 			
-			// Remove the trailing '::'
-			content.resize( content.size() - 2 );
-			
-			input++; // Read in the '*'
-			skip_spaces( input );
-			
-			layers.push_back( { layer_type::member_pointer , content } ); // <node_type>
-			
-			while( node_cv_qual( input ) );
-			
-			// skip_spaces( input ); // Unnecessary, since node_ptr_or_ref also invokes skip_spaces( input ) after call to node_mem_ptr
-			
-			return true;
-		}
-		
-		/**
-		 * <node_array_func>	:=
-		 *  -  [ <node_array_func> ] '(' PARAMETERS ')' { <node_cv_qual> }
-		 *	-  [ <node_array_func> ] '[' CONSTANT ']'
-		 *	-  '(' <node_type_qual> ')'
-		 */
-		bool node_array_func( const char*& input )
-		{
-			if( !*input )
-				return false;
-			
-			size_t insert_pos = layers.size();
-			
-			for( int num_tries = 0; true ; num_tries++ )
+			//! <node_array_func>
+			constexpr bool node_array_func( frame& f , int depth )
 			{
-				const char* input_backup = input;
-				for( int cur_try = 0 ; cur_try < num_tries ; cur_try++ )
+				cursor		input_backup = input;
+				snapshot	pools_backup = save();
+				size_t		insert_pos = f.size;
+				size_t		num_group_layers = 0;
+				bool		is_first = true;
+				
+				while( *input && *input != ')' && *input != ',' )
 				{
 					if( *input == '[' ) // Must be array
 					{
 						input++;
-						skip_spaces( input );
-						int open_parens = 0;
-						std::string content;
+						skip_spaces();
+						int			open_parens = 0;
+						const char*	content_begin = input.pos;
 						while( *input && ( *input != ']' || open_parens > 0 ) ){
 							if( *input == '[' )
 								open_parens++;
 							else if( *input == ']' )
 								open_parens--;
-							content += *input++;
+							input++;
 						}
 						if( !*input )
-							return false;
-						layers.insert( layers.begin() + insert_pos , { layer_type::array ,content } ); // <node_array_func>.2
+							return backtrack( f , input_backup , pools_backup , insert_pos );
+						f.push( layer_type::array );
+						f.back().content_begin = result.text_size;
+						f.back().content_size = input.pos - content_begin;
+						append( content_begin , input.pos );
 						input++; // Read the ']'
-						skip_spaces( input );
+						skip_spaces();
 					}
 					else if( *input == '(' )
 					{
+						if( depth >= grammar<type>::max_nesting_depth )
+							return backtrack( f , input_backup , pools_backup , insert_pos );
 						input++;
-						skip_spaces( input );
-						const char* input_backup_2 = input;
-						if( cur_try == 0 && node_type_qual( input ) && *input == ')' ){
+						skip_spaces();
+						if( is_first && starts_declarator( f ) ){
+							// See grammar::node_array_func()
+							if( !node_type_qual( f , depth + 1 ) || *input != ')' )
+								return backtrack( f , input_backup , pools_backup , insert_pos );
+							num_group_layers = f.size - insert_pos;
 							input++;
-							skip_spaces( input );
+							skip_spaces();
 						}
 						else{ // Must be PARAMETERS
-							input = input_backup_2;
-							auto res = layers.insert( layers.begin() + insert_pos , { layer_type::function } ); // <node_array_func>.2
-							while(true){
-								type param{nullptr};
-								const char* input_backup_3 = input;
-								param.node_type(input); // Read in one parameter
-								if( param.layers.empty() ){
+							f.push( layer_type::function );
+							
+							range	params[N] = {};
+							size_t	num_params = 0;
+							while( *input != ')' ){
+								frame	param;
+								cursor	input_backup_3 = input;
+								if( !node_type( param , depth + 1 ) ){ // Read in one parameter
 									input = input_backup_3;
 									break;
 								}
-								res->arguments.push_back( std::make_shared<type>( std::move(param) ) );
+								params[num_params++] = commit( param );
 								if( *input != ',' )
 									break;
 								input++; // Read the ','
-								skip_spaces(input);
+								skip_spaces();
 							}
 							if( *input != ')' )
-								goto breakout;
+								return backtrack( f , input_backup , pools_backup , insert_pos );
+							
+							f.back().first_argument = result.num_arguments;
+							f.back().num_arguments = num_params;
+							for( size_t i = 0 ; i < num_params ; i++ )
+								result.arguments[result.num_arguments++] = params[i];
 							
 							input++; // Read the ')'
-							skip_spaces( input );
-							while( node_cv_qual( input ) );
+							skip_spaces();
+							while( node_cv_qual( f ) );
 						}
 					}
+					else if( is_first )
+						return backtrack( f , input_backup , pools_backup , insert_pos );
 					else
-						goto breakout;
-					
-					continue;
-					
-				breakout:
+						break;
 					
-					// Backtrack and restore
-					input = input_backup;
-					layers.resize( insert_pos );
-					return false;
+					is_first = false;
 				}
-				if( !*input || *input == ')' || *input == ',' )
-					return num_tries > 0;
 				
-				// Backtrack and restore
+				if( is_first )
+					return false;
+				
+				// Suffixes bind from the inside out: Reverse them and move the group layers in front of them
+				layer* first = f.layers + insert_pos;
+				layer* middle = first + num_group_layers;
+				layer* last = f.layers + f.size;
+				reverse( first , middle );
+				reverse( first , last );
+				return true;
+			}
+			
+			constexpr bool backtrack( frame& f , const cursor& input_backup , const snapshot& pools_backup , size_t insert_pos ){
 				input = input_backup;
-				layers.resize( insert_pos );
+				restore( pools_backup );
+				f.size = insert_pos;
+				return false;
 			}
+		};
+	}
+	
+	/**
+	 * Parses the C++ typename 'str' in a constant expression, e.g.
+	 *     constexpr auto t = parser::parse_static( "const int (*)[4]" );
+	 * Throws std::invalid_argument (i.e. fails to compile within a constant expression), if 'str' is not a valid type.
+	 */
+	template<size_t N>
+	constexpr static_type<N> parse_static( const char (&str)[N] )
+	{
+		static_type<N> result;
+		detail::static_grammar<N>{ result , detail::cursor( std::string_view( str , N - 1 ) ) }.parse();
+		return result;
+	}
+	
+	#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+	namespace detail
+	{
+		//! String literal usable as template argument
+		template<size_t N>
+		struct fixed_string
+		{
+			char data[N] = {};
 			
-			return true; // Dead code
-		}
-		
-	private:
+			constexpr fixed_string( const char (&str)[N] ){
+				for( size_t i = 0 ; i < N ; i++ )
+					data[i] = str[i];
+			}
+		};
 		
-		template<typename T, bool = std::is_reference<T>::value || std::is_array<T>::value || std::is_pointer<T>::value>
-		struct from_type_helper{ static void work( type& dest ){
-			dest.layers.push_back( { layer_type::type , detail::get_typename<T>() } );
-		} };
-		template<typename T>
-		struct from_type_helper<const T,false>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.back().is_const = true;
-		} };
-		template<typename T>
-		struct from_type_helper<volatile T,false>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.back().is_volatile = true;
-		} };
-		template<typename T, bool B>
-		struct from_type_helper<T*,B>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.push_back( { layer_type::pointer } );
-		} };
-		template<typename T, bool B>
-		struct from_type_helper<T&,B>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.push_back( { layer_type::lvalue } );
-		} };
-		template<typename T, bool B>
-		struct from_type_helper<T&&,B>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.push_back( { layer_type::rvalue } );
-		} };
-		template<typename T, bool B>
-		struct from_type_helper<T[],B>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.push_back( { layer_type::array } );
-		} };
-		template<typename T, size_t N, bool B>
-		struct from_type_helper<T[N],B>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.push_back( { layer_type::array , detail::to_string(N) } );
-		} };
-		template<typename T, class C, bool B>
-		struct from_type_helper<T (C::*),B>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.push_back( { layer_type::member_pointer , detail::get_typename<C>() } );
-		} };
-		template<typename T, typename... A, bool B>
-		struct from_type_helper<T(A...),B>{ static void work( type& dest ){
-			from_type_helper<T>::work( dest );
-			dest.layers.push_back( { layer_type::function } );
-			detail::variadic_comma_type dummy{ (dest.layers.back().arguments.emplace_back( std::make_shared<type>( type::from_type<A>() ) ), 0)... };
-		} };
-	};
+		template<fixed_string str>
+		inline constexpr auto static_type_v = parse_static( str.data );
+	}
+	
+	//! Returns the parse result of 'str', which is computed at compile time (e.g. parser::parse<"const int (*)[4]">())
+	template<detail::fixed_string str>
+	constexpr const auto& parse(){
+		return detail::static_type_v<str>;
+	}
+	#endif
 	
 } // namespace parser
 
+namespace std
+{
+	template<>
+	struct hash<parser::type>
+	{
+		size_t operator()( const parser::type& t ) const { return t.hash(); }
+	};
+}
+
 #endif
@@ -3,7 +3,11 @@
 cd %~dp0
 
 echo Compiling with G++...
-g++ -std=c++11 -I"../include" -O2 -Wall -o test.exe *.cpp
+g++ -std=c++17 -I"../include" -O2 -Wall -pthread -o test.exe example.cpp
+
+IF %ERRORLEVEL% NEQ 0 GOTO ERROR
+
+g++ -std=c++17 -I"../include" -O2 -Wall -pthread -o tests.exe tests.cpp
 
 IF %ERRORLEVEL% NEQ 0 GOTO ERROR
 
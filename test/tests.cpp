@@ -0,0 +1,693 @@
+#include "cpp-typename-parser.h"
+#include "cpp-typename-parser-batch.h"
+#include "cpp-typename-parser-cache.h"
+#include "cpp-typename-parser-stream.h"
+#include "cpp-typename-parser-database.h"
+#include "cpp-typename-parser-find.h"
+#include "cpp-typename-parser-persistent.h"
+#include "cpp-typename-parser-lazy.h"
+#include "cpp-typename-parser-table.h"
+#include "cpp-typename-parser-pattern.h"
+#include "cpp-typename-parser-universe.h"
+#include <cstdio>
+#include <chrono>
+#include <unordered_set>
+
+static int num_failures = 0;
+
+#define CHECK( condition ) \
+	if( !( condition ) ){ \
+		std::printf( "%s:%d: CHECK( %s ) failed\n" , __FILE__ , __LINE__ , #condition ); \
+		num_failures++; \
+	}
+
+struct TestClass{};
+
+//! Parsing the output of to_string() again yields the same type
+void test_round_trip()
+{
+	const char* inputs[] = {
+		"int" , "const int (*)[4]" , "unsigned const int" , "void (*(*)(int, char))(double)" , "int (A::*)(int) const"
+		, "std::map<int, std::vector<int>>" , "char const* volatile* const" , "int&&" , "int (&)[3][4]" , "long long unsigned"
+		, "A::B::C" , "int ::A::*" , "const volatile unsigned long int * const &" , "int[2][3]" , "int (*(*)[3])(float)"
+		, "::std::string" , "void (*)(int (*)(char (&)[2]), long (A::*)(short) volatile)" , "A<(1>2), B<C>>"
+	};
+	for( const char* input : inputs ){
+		parser::type t( input );
+		CHECK( parser::type( t.to_string() ) == t );
+	}
+	CHECK( parser::type( "int (*)[4]" ).to_string( "var" ) == "int (* var)[4]" );
+	CHECK( parser::type( "const int * const" ).is_const() );
+	CHECK( parser::type( "int(&)(long)" ).is_lvalue_reference() );
+}
+
+void test_from_type()
+{
+	CHECK( parser::type::from_type<int*>() == parser::type( "int*" ) );
+	CHECK( parser::type::from_type<const char(&)[4]>() == parser::type( "const char(&)[4]" ) );
+	CHECK( parser::type::from_type<unsigned int const (::TestClass::*const)(int,const double&)>().is_member_pointer() );
+	CHECK( &parser::type::from_type_ref<long>() == &parser::type::from_type_ref<long>() );
+	
+	parser::type function = parser::type::from_type<void(int)>();
+	( function.begin() + 1 )->arguments[0]->add_const();
+	CHECK( parser::type::from_type<void(int)>() == parser::type( "void(int)" ) );
+}
+
+//! Views read every input like types do, only without copying the contents
+void test_type_view()
+{
+	const char* inputs[] = {
+		"int" , "const int (*)[4]" , "unsigned const int" , "long long unsigned" , "void (*(*)(int, char))(double)" , "int (A::*)(int) const"
+		, "std::map<int, std::vector<int>>" , "char const* volatile* const" , "int&&" , "int (&)[3][4]" , "::std::string" , "int ::A::*"
+		, "const volatile unsigned long int * const &" , "void (*)(int (*)(char (&)[2]), long (A::*)(short) volatile)" , "A<(1>2), B<C>>"
+		, "int (*(*)[3])(float)" , "signed char" , "void (...)" , "int*)" , "int ]" , "const" , ""
+	};
+	for( const char* input : inputs ){
+		parser::type_view view( input );
+		parser::type expected( input );
+		CHECK( view.to_string() == expected.to_string() );
+		CHECK( view.to_string( "x" ) == expected.to_string( "x" ) );
+		CHECK( view.to_owned() == expected );
+		CHECK( view.get_datatype() == expected.get_datatype() && view.is_pointer() == expected.is_pointer() );
+	}
+}
+
+//! Types parsed into an arena equal those on the heap and survive its release() as copies
+void test_type_arena()
+{
+	const char* inputs[] = {
+		"int" , "const int (*)[4]" , "void (*(*)(int, char))(double)" , "int (A::*)(int) const" , "char const* volatile* const* const&"
+		, "void (*)(int (*)(char (&)[2]), long (A::*)(short) volatile)" , "std::map<int, std::vector<int>>"
+	};
+	parser::type_arena arena;
+	std::vector<parser::type> copies;
+	for( int round = 0 ; round < 2 ; round++ ){
+		{
+			std::vector<parser::type> types;
+			for( const char* input : inputs ){
+				types.emplace_back( input , &arena );
+				CHECK( types.back() == parser::type( input ) );
+				CHECK( types.back().get_allocator().resource() == &arena );
+			}
+			for( const parser::type& t : types )
+				copies.emplace_back( t ); // Copies use the default allocator
+		}
+		arena.release();
+	}
+	for( size_t i = 0 ; i < copies.size() ; i++ ){
+		CHECK( copies[i] == parser::type( inputs[i % std::size( inputs )] ) );
+		CHECK( copies[i].get_allocator().resource() == std::pmr::get_default_resource() );
+	}
+}
+
+void test_parse()
+{
+	parser::type t;
+	CHECK( t.parse( "int*" ) && t.is_pointer() );
+	CHECK( !t.parse( "int*)" ) );
+	CHECK( parser::type( "std::array<int, 4>" ).get_datatype() == "std::array<int, 4>" );
+}
+
+void test_deep_nesting()
+{
+	// Each parenthesized declarator used to be parsed twice (as group and as parameter list), doubling the time per level
+	std::string member_pointers = "int";
+	std::string bad_parameters = "int";
+	for( int i = 0 ; i < 200 ; i++ ){
+		member_pointers += "(A::*";
+		bad_parameters += "(A::*";
+	}
+	member_pointers += "@";
+	bad_parameters += "x";
+	for( int i = 0 ; i < 200 ; i++ ){
+		member_pointers += ")";
+		bad_parameters += ", int)";
+	}
+	auto start = std::chrono::steady_clock::now();
+	CHECK( !parser::type().parse( member_pointers ) );
+	CHECK( !parser::type().parse( bad_parameters ) );
+	CHECK( std::chrono::steady_clock::now() - start < std::chrono::seconds( 1 ) );
+	
+	CHECK( parser::type( "void (*)(int)" ).is_pointer() );
+	CHECK( parser::type( "int (A::*)(int) const" ).is_member_pointer() );
+	CHECK( parser::type( "int (*)[3]" ).is_pointer() );
+	CHECK( parser::type( "void (int (*)(char), long)" ).to_string() == "void (int (*)(char),long)" );
+	CHECK( parser::type( "void ((*))" ).is_pointer() );
+	static_assert( parser::parse_static( "void (*(*)(int))(long)" ).is_pointer() , "Groups are parsed by parse_static() as well" );
+}
+
+void test_template_arguments()
+{
+	parser::type t( "std::map<std::string, A<(1>2)>>*" );
+	const parser::template_argument_list& arguments = t.template_arguments();
+	CHECK( arguments.size() == 2 );
+	CHECK( arguments.size() == 2 && arguments[0].is_type() && *arguments[0].value == parser::type( "std::string" ) );
+	CHECK( arguments.size() == 2 && arguments[1].is_type() && arguments[1].value->template_arguments().size() == 1 );
+	CHECK( &t.template_arguments() == &arguments );
+	CHECK( parser::type( "int" ).template_arguments().empty() );
+	CHECK( !parser::type( "std::array<int, 4>" ).template_arguments()[1].is_type() );
+}
+
+void test_canonical()
+{
+	CHECK( parser::type::parse_canonical( "int unsigned" ) == parser::type::parse_canonical( "unsigned" ) );
+	CHECK( parser::type::parse_canonical( "long int const" ) == parser::type::parse_canonical( "const long" ) );
+	CHECK( parser::type::parse_canonical( "::std::vector< int unsigned >" ).to_string() == "std::vector<unsigned int>" );
+	CHECK( parser::type::parse_canonical( "void (*)(char signed)" ).to_string() == "void (*)(signed char)" );
+	CHECK( parser::type::parse_canonical( "A<B<int>,C>" ).is_canonical() );
+	CHECK( !parser::type( "long int" ).is_canonical() );
+	
+	// Deeply nested template arguments are canonicalized up to the nesting limit and left as they are beyond it
+	auto nested = []( int depth , std::string_view prefix , std::string_view inner , std::string_view suffix ){
+		std::string result;
+		for( int i = 0 ; i < depth ; i++ )
+			result += prefix;
+		result += inner;
+		for( int i = 0 ; i < depth ; i++ )
+			result += suffix;
+		return result;
+	};
+	CHECK( parser::type::parse_canonical( nested( 200 , "::A< " , "int unsigned" , " >" ) ).to_string() == nested( 200 , "A<" , "unsigned int" , ">" ) );
+	CHECK( parser::type::parse_canonical( nested( 100 , "A<" , "long const" , "*>" ) ) == parser::type::parse_canonical( nested( 100 , "A<" , "const long" , "*>" ) ) );
+	auto start = std::chrono::steady_clock::now();
+	CHECK( parser::type::parse_canonical( nested( 100000 , "A<" , "int unsigned" , ">" ) ).to_string() == nested( 100000 , "A<" , "int unsigned" , ">" ) );
+	CHECK( parser::type::parse_canonical( nested( 100000 , "A<" , "int" , "*>" ) ) );
+	CHECK( std::chrono::steady_clock::now() - start < std::chrono::seconds( 1 ) );
+}
+
+//! The global symbol table never shrinks, but the memory it takes can be limited
+void test_symbol_table()
+{
+	parser::symbol_table& table = parser::symbol_table::global();
+	size_t usage = table.memory_usage();
+	CHECK( parser::type( "limited_name*" ) && table.memory_usage() > usage );
+	
+	table.set_memory_limit( table.memory_usage() + 64 );
+	bool is_limited = false;
+	try{
+		parser::type( "a_name_that_is_too_long_for_the_remaining_64_bytes_of_the_limit" );
+	}
+	catch( const std::length_error& ){
+		is_limited = true;
+	}
+	CHECK( is_limited );
+	CHECK( parser::type( "const limited_name&" ) ); // Names already present are found as before
+	table.set_memory_limit( 0 );
+	CHECK( parser::type( "a_name_that_is_too_long_for_the_remaining_64_bytes_of_the_limit" ) );
+}
+
+void test_hash()
+{
+	std::unordered_set<parser::type> set{ parser::type( "int*" ) , parser::type( "const char*" ) };
+	CHECK( set.count( parser::type( "int *" ) ) == 1 );
+	CHECK( set.count( parser::type( "char const*" ) ) == 1 );
+	CHECK( set.count( parser::type( "char*" ) ) == 0 );
+	parser::type t( "int" );
+	size_t hash = t.hash();
+	t.add_const();
+	CHECK( t.hash() != hash );
+	
+	// Arguments may be modified behind the back of the function type
+	parser::type function( "void(int)" );
+	parser::type other( "void(const int)" );
+	std::shared_ptr<parser::type> argument = ( function.cbegin() + 1 )->arguments[0];
+	CHECK( function.hash() != other.hash() && function != other );
+	argument->add_const();
+	CHECK( function.hash() == other.hash() && function == other );
+}
+
+//! Types of up to 4 layers (without parameters) are stored within the type object
+void test_inline_layers()
+{
+	std::pmr::memory_resource* no_memory = std::pmr::null_memory_resource(); // Throws on every allocation
+	parser::type t( "char const* const*&" , no_memory );
+	CHECK( t.is_lvalue_reference() );
+	parser::type copy( t , no_memory );
+	copy.remove_reference();
+	copy.set_datatype( parser::type( "int" ) );
+	CHECK( copy == parser::type( "int* const*" ) );
+	bool threw = false;
+	try{ parser::type( "int*****" , no_memory ); }catch( const std::bad_alloc& ){ threw = true; }
+	CHECK( threw );
+	CHECK( parser::type( "int*****" ).to_string() == "int *****" );
+}
+
+void test_mangled()
+{
+	CHECK( parser::type::from_mangled( "PKc" ) == parser::type( "const char*" ) );
+	CHECK( parser::type::from_mangled( "A3_PFvlOsE" ) == parser::type( "void (*[3])(long,short&&)" ) );
+	CHECK( parser::type::from_mangled( "N2ns3BarIcLin3EEE" ).to_string() == "ns::Bar<char, -3>" );
+	CHECK( !parser::type::from_mangled( "P" ) );
+	CHECK( parser::type::from_mangled( "M5ClassFivE" ) == parser::type( "int (Class::*)()" ) );
+	CHECK( parser::type::from_mangled( "RKSs" ) == parser::type( "const std::string&" ) );
+	CHECK( parser::type::from_mangled( "FvPKcS_S0_E" ) == parser::type( "void (const char*, const char, const char*)" ) );
+	CHECK( parser::type::from_mangled( "FvN2ns1AES0_E" ) == parser::type( "void (ns::A, ns::A)" ) );
+	
+	// Deep nesting and substitutions expanding exponentially fail instead of exhausting stack or memory
+	CHECK( !parser::type::from_mangled( std::string( 100000 , 'P' ) + "i" ) );
+	CHECK( parser::type::from_mangled( std::string( 200 , 'P' ) + "i" ) );
+	std::string chain = "PFvPiS_S_E";
+	for( int i = 1 ; i < 35 ; i += 2 ){
+		char index = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"[i]; // Refers to the previous pointer to function
+		chain = "PFv" + chain + "S" + index + "_S" + index + "_E";
+	}
+	auto start = std::chrono::steady_clock::now();
+	CHECK( !parser::type::from_mangled( chain ) );
+	CHECK( std::chrono::steady_clock::now() - start < std::chrono::seconds( 1 ) );
+}
+
+void test_static()
+{
+	constexpr auto t = parser::parse_static( "const int (*)[4]" );
+	static_assert( t.is_pointer() , "parse_static() is evaluated at compile time" );
+	CHECK( t.to_type() == parser::type( "const int (*)[4]" ) );
+}
+
+void test_batch_and_cache()
+{
+	std::vector<parser::batch_entry> entries = parser::parse_batch( "int*\nconst char&\nint*)\n" );
+	CHECK( entries.size() == 3 );
+	CHECK( entries.size() == 3 && entries[0].success && entries[1].success && !entries[2].success );
+
+	parser::type_cache cache( 4 , 1 );
+	CHECK( cache.get( "int*" ) == cache.get( "int*" ) );
+	CHECK( cache.stats().hits == 1 );
+	for( const char* name : { "a" , "b" , "c" , "d" , "e" } )
+		cache.get( name );
+	CHECK( cache.size() <= cache.capacity() );
+	
+	// Callers that miss concurrently all get the one cached type
+	parser::type_cache shared_cache;
+	std::vector<std::shared_ptr<const parser::type>> results( 8 );
+	std::vector<std::thread> threads;
+	for( auto& result : results )
+		threads.emplace_back( [&shared_cache,&result]{ result = shared_cache.get( "std::map<int, long>" ); } );
+	for( std::thread& thread : threads )
+		thread.join();
+	CHECK( std::all_of( results.begin() , results.end() , [&]( const auto& result ){ return result == results[0]; } ) );
+}
+
+//! Feeding a stream in chunks of any size yields the same entries as parsing it at once
+void test_stream()
+{
+	using namespace std::string_literals;
+	std::string input = "int*\nstd::map<int, std::vector<int>> const&\n\nvoid (*)(int)\0int*)\nunsigned long"s;
+	std::vector<parser::batch_entry> expected = parser::parse_batch( input );
+	for( size_t chunk_size = 1 ; chunk_size <= input.size() ; chunk_size++ ){
+		std::vector<parser::batch_entry> entries;
+		parser::stream_parser stream( [&entries]( parser::batch_entry&& entry ){ entries.push_back( std::move(entry) ); } );
+		for( size_t offset = 0 ; offset < input.size() ; offset += chunk_size )
+			stream.feed( std::string_view( input ).substr( offset , chunk_size ) );
+		CHECK( stream.pending_size() == 13 );
+		stream.finish();
+		CHECK( entries.size() == expected.size() );
+		for( size_t i = 0 ; i < entries.size() && i < expected.size() ; i++ )
+			CHECK( entries[i].success == expected[i].success && entries[i].value == expected[i].value );
+	}
+	
+	// Entries longer than the limit fail, however they are split into chunks
+	std::string long_entries = "int*\nstd::map<int, long>\nlong\nstd::vector<int>";
+	for( size_t chunk_size = 1 ; chunk_size <= long_entries.size() ; chunk_size++ ){
+		std::vector<parser::batch_entry> entries;
+		parser::stream_parser stream( [&entries]( parser::batch_entry&& entry ){ entries.push_back( std::move(entry) ); } , 8 );
+		for( size_t offset = 0 ; offset < long_entries.size() ; offset += chunk_size )
+			stream.feed( std::string_view( long_entries ).substr( offset , chunk_size ) );
+		CHECK( stream.pending_size() <= 8 );
+		stream.finish();
+		CHECK( entries.size() == 4 && entries[0].success && !entries[1].success && entries[2].success && !entries[3].success );
+		CHECK( stream.overflow_count() == 2 );
+	}
+	
+	// Free-form text yields the same names as find_types() over all of it
+	std::string text = "error: cannot convert 'const char*' to 'int'\n  in std::vector<int>::push_back(int&&)\n\nlong line: a very long time\nvoid (*)(int)";
+	std::vector<parser::found_type> expected_names = parser::find_types( text );
+	auto same_names = []( const std::vector<parser::found_type>& lhs , const parser::found_type* rhs_begin , const parser::found_type* rhs_end ){
+		return std::equal( lhs.begin() , lhs.end() , rhs_begin , rhs_end , []( const parser::found_type& lhs , const parser::found_type& rhs ){
+			return lhs.offset == rhs.offset && lhs.length == rhs.length && lhs.value == rhs.value;
+		} );
+	};
+	for( size_t chunk_size = 1 ; chunk_size <= text.size() ; chunk_size++ ){
+		std::vector<parser::found_type> names;
+		parser::stream_finder stream( [&names]( parser::found_type&& found ){ names.push_back( std::move(found) ); } );
+		for( size_t offset = 0 ; offset < text.size() ; offset += chunk_size )
+			stream.feed( std::string_view( text ).substr( offset , chunk_size ) );
+		stream.finish();
+		CHECK( same_names( names , expected_names.data() , expected_names.data() + expected_names.size() ) );
+	}
+	
+	// Lines longer than the limit are skipped, if they need to be kept
+	std::vector<parser::found_type> names;
+	parser::stream_finder stream( [&names]( parser::found_type&& found ){ names.push_back( std::move(found) ); } , 40 );
+	for( char c : text )
+		stream.feed( std::string_view( &c , 1 ) );
+	stream.finish();
+	CHECK( stream.overflow_count() == 1 && stream.pending_size() == 0 );
+	CHECK( expected_names.size() > 2 && same_names( names , expected_names.data() + 2 , expected_names.data() + expected_names.size() ) ); // Skips "const char*" and "int"
+}
+
+//! Types read back from a database equal the types written
+void test_database()
+{
+	const char* inputs[] = {
+		"int" , "const int (*)[4]" , "void (*(*)(int, char))(double)" , "int (A::*)(int) const" , "std::map<int, std::vector<int>>"
+		, "char const* volatile* const" , "void (*)(int (*)(char (&)[2]), long (A::*)(short) volatile)" , "int (*)(int)" , "int"
+	};
+	parser::type_database_writer writer;
+	for( const char* input : inputs )
+		writer.add( parser::type( input ) );
+	std::string data = writer.serialize();
+	
+	parser::type_database database( data );
+	CHECK( database.size() == std::size( inputs ) );
+	for( size_t i = 0 ; i < database.size() && i < std::size( inputs ) ; i++ ){
+		parser::type expected( inputs[i] );
+		parser::database_type t = database[i];
+		CHECK( t.to_type() == expected );
+		CHECK( t.to_string( "x" ) == expected.to_string( "x" ) );
+		CHECK( t.get_datatype() == expected.get_datatype() );
+		CHECK( t.is_pointer() == expected.is_pointer() && t.is_const() == expected.is_const() && t.is_plain() == expected.is_plain() );
+		CHECK( t.size() == size_t( expected.end() - expected.begin() ) );
+	}
+	
+	// Corrupt records are either read or rejected, but never read beyond the database
+	for( size_t pos = 0 ; pos < data.size() ; pos++ )
+		for( char corruption : { '\x00' , '\x7F' , '\xFF' } ){
+			std::string corrupt = data;
+			corrupt[pos] = corruption;
+			try{
+				parser::type_database corrupt_database( std::string_view( corrupt.data() , corrupt.size() ) );
+				for( size_t i = 0 ; i < corrupt_database.size() ; i++ )
+					corrupt_database[i].to_string() , corrupt_database[i].to_type() , corrupt_database[i].is_pointer();
+			}
+			catch( std::runtime_error& ){}
+		}
+	
+	data[0] = 'X';
+	bool rejected = false;
+	try{ parser::type_database{ data }; }
+	catch( std::runtime_error& ){ rejected = true; }
+	CHECK( rejected );
+	
+	// Chains of types 'void (*)(T,...)', whose 'num_arguments' arguments all refer to the previous type T, starting with 'int'
+	auto make_chain = []( std::uint32_t num_types , std::uint32_t num_arguments ){
+		std::string records;
+		std::vector<std::uint32_t> offsets;
+		for( std::uint32_t i = 0 ; i < num_types ; i++ ){
+			offsets.push_back( std::uint32_t( records.size() ) );
+			std::string layers;
+			if( i == 0 )
+				layers += { '\x00' , '\x02' }; // int
+			else{
+				layers += { '\x00' , '\x01' , '\x05' , '\x00' }; // void (
+				parser::detail::write_varint( layers , num_arguments );
+				for( std::uint32_t j = 0 ; j < num_arguments ; j++ )
+					parser::detail::write_varint( layers , i - 1 );
+				layers += { '\x01' , '\x00' }; // (*)
+			}
+			parser::detail::write_varint( records , i ? 3 : 1 );
+			parser::detail::write_varint( records , std::uint32_t( i ? layers.size() - 2 : 0 ) );
+			records += layers;
+		}
+		std::string result( "CTPDB\r\n\x1A" , 8 );
+		std::uint32_t strings = std::uint32_t( parser::detail::database_header_size );
+		std::uint32_t types = strings + 16 + 7;
+		std::uint32_t entries = types + 4 * num_types + std::uint32_t( records.size() );
+		for( std::uint32_t value : { 2u , 3u , num_types , 1u , strings , strings + 16 , types , types + 4 * num_types , entries , 0u , 0u , 4u , 7u } )
+			parser::detail::write_u32( result , value );
+		result += "voidint";
+		for( std::uint32_t offset : offsets )
+			parser::detail::write_u32( result , offset );
+		result += records;
+		parser::detail::write_u32( result , num_types - 1 );
+		return result;
+	};
+	auto is_rejected = []( const parser::database_type& t ){
+		int num_rejected = 0;
+		try{ t.to_string(); }
+		catch( std::runtime_error& ){ num_rejected++; }
+		try{ t.to_type(); }
+		catch( std::runtime_error& ){ num_rejected++; }
+		return num_rejected == 2;
+	};
+	std::string chain = make_chain( 3 , 2 );
+	CHECK( parser::type_database( chain )[0].to_type() == parser::type( "void (*)(void (*)(int, int), void (*)(int, int))" ) );
+	chain = make_chain( 64 , 2 ); // Expands exponentially
+	CHECK( is_rejected( parser::type_database( chain )[0] ) );
+	chain = make_chain( 100000 , 1 ); // Nests deeply
+	CHECK( is_rejected( parser::type_database( chain )[0] ) );
+	chain = make_chain( 200 , 1 );
+	CHECK( parser::type_database( chain )[0].to_string().size() > 200 );
+}
+
+//! The vectorized scanners agree with the scalar ones for every length and alignment
+void test_scanners()
+{
+	namespace scan = parser::detail::scan;
+	const char characters[] = "aZ_09<>()[]{} ,:*&\x80\xFF;Y`@";
+	std::string input;
+	for( int i = 0 ; i < 200 ; i++ )
+		input += characters[( i * 7 + i / 3 ) % ( sizeof(characters) - 1 )];
+	const char* begin = input.data();
+	const char* end = begin + input.size();
+	const scan::implementation& selected = scan::selected();
+	for( const char* pos = begin ; pos != end ; pos++ ){
+		for( const char* last = pos ; last != end ; last++ ){
+			CHECK( selected.find_bracket( pos , last ) == scan::find_bracket_scalar( pos , last ) );
+			CHECK( selected.skip_identifier( pos , last ) == scan::skip_identifier_scalar( pos , last ) );
+		}
+		if( end - pos >= 64 )
+			CHECK( selected.identifier_mask64( pos ) == scan::identifier_mask64_scalar( pos ) );
+	}
+	std::string identifier( 100 , 'x' );
+	CHECK( parser::detail::skip_identifier( identifier.data() , identifier.data() + 100 ) == identifier.data() + 100 );
+	CHECK( parser::type( "int[(a[1])]" ).is_array() );
+	CHECK( parser::detail::find_final_template_id( "A<B<(1>2)>>::C<D>" ) != nullptr );
+	CHECK( parser::detail::find_final_template_id( "A<B>::C" ) == nullptr );
+}
+
+//! Type names are found within free-form text together with their position
+void test_find_types()
+{
+	parser::type t;
+	CHECK( t.parse_prefix( "  const char* x = 0;" ) == 13 && t == parser::type( "const char*" ) );
+	CHECK( t.parse_prefix( "std::vector<int> >" ) == 16 && t == parser::type( "std::vector<int>" ) );
+	CHECK( t.parse_prefix( "+int" ) == 0 );
+	
+	std::string_view text =
+		"main.cpp:12: error: cannot convert 'std::vector<int>*' to 'const char (&)[4]'\n"
+		"0000000000001139 T foo(int, char const*)\n"
+		"a long time ago, ::ns::Widget was 0x1f big\n"
+	;
+	std::vector<parser::found_type> found = parser::find_types( text );
+	const char* expected[] = { "std::vector<int>*" , "const char (&)[4]" , "foo(int, char const*)" , "long" , "::ns::Widget" };
+	CHECK( found.size() == std::size( expected ) );
+	for( size_t i = 0 ; i < found.size() && i < std::size( expected ) ; i++ ){
+		CHECK( text.substr( found[i].offset , found[i].length ) == expected[i] );
+		CHECK( found[i].value == parser::type( expected[i] ) );
+	}
+	
+	// Long lines without matches take linear time (8 times the text may take 8, but not 64 times as long)
+	for( const char* unit : { "a<" , "a[" , "a(" , "const " } ){
+		double seconds[2];
+		for( int i = 0 ; i < 2 ; i++ ){
+			std::string line;
+			for( int j = 0 ; j < ( i ? 64000 : 8000 ) ; j++ )
+				line += unit;
+			auto start = std::chrono::steady_clock::now();
+			parser::find_types( line );
+			seconds[i] = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+		}
+		CHECK( seconds[1] < 16 * seconds[0] + 0.05 );
+	}
+	CHECK( parser::find_types( "(int*) a<b foo(a[) const char&" ).size() == 2 );
+}
+
+//! Variants derived from a persistent_type share its layers and equal the corresponding types
+void test_persistent()
+{
+	const char* inputs[] = { "int" , "const int (*)[4]" , "void (*(*)(int, char))(double)" , "int (A::*)(int) const" , "std::map<int, std::vector<int>>&&" };
+	for( const char* input : inputs ){
+		parser::type t( input );
+		parser::persistent_type p( t );
+		CHECK( p.to_type() == t && p.to_string() == t.to_string() && p.hash() == t.hash() );
+	}
+	
+	parser::persistent_type base( "std::string" );
+	parser::persistent_type ref = base.add_const().add_lvalue_reference();
+	CHECK( ref.to_type() == parser::type( "const std::string&" ) );
+	CHECK( ref.inner().inner() != base && ref.remove_reference().remove_const() == base );
+	CHECK( base.add_pointer().add_const() == parser::persistent_type( "std::string* const" ) );
+	CHECK( base.add_function( { base.add_pointer() , parser::persistent_type( "int" ) } ).add_pointer().to_string() == "std::string (*)(std::string *,int)" );
+	CHECK( ref.set_datatype( parser::persistent_type( "ns::Widget" ) ).to_type() == parser::type( "ns::Widget&" ) );
+	CHECK( ref.is_lvalue_reference() && !ref.is_const() && ref.get_datatype() == "std::string" );
+}
+
+void test_lazy()
+{
+	const char* inputs[] = {
+		"int" , "const int" , "int const" , "unsigned const long" , "volatile std::vector<const int>" , "int*" , "int* const" ,
+		"const int* volatile" , "int&" , "int&&" , "int A::*" , "int A::* const" , "const char (&)[4]" , "int[3]" ,
+		"void (*)(int)" , "int (A::*)(int) const" , "std::map<int, std::vector<int>>&&" , "::ns::T<1>" , "void" , "myconst" ,
+		"int (*)[3]" , "int (*[3])(int)" , "void (*(*)(int))(double)" , "int (&)(int)" , "int[3][4]" , "void (int)" ,
+		"void (* const)(int) const" , "int (*)"
+	};
+	for( const char* input : inputs ){
+		parser::type t( input );
+		parser::lazy_type l( input );
+		CHECK( l.is_plain() == t.is_plain() && l.is_pointer() == t.is_pointer() && l.is_member_pointer() == t.is_member_pointer() );
+		CHECK( l.is_lvalue_reference() == t.is_lvalue_reference() && l.is_rvalue_reference() == t.is_rvalue_reference() );
+		CHECK( l.is_array() == t.is_array() && l.is_const() == t.is_const() && l.is_volatile() == t.is_volatile() );
+		CHECK( l.get_datatype() == t.get_datatype() && l.is_void() == t.is_void() );
+		CHECK( l.to_string() == t.to_string() && l.is_parsed() );
+	}
+	
+	parser::lazy_type l( "const std::string* const" );
+	CHECK( l.is_pointer() && l.is_const() && l.get_datatype() == "std::string" && !l.is_parsed() );
+	l.remove_const();
+	CHECK( l.is_parsed() && !l.is_const() && l.get() == parser::type( "const std::string*" ) );
+}
+
+void test_type_table()
+{
+	std::vector<parser::type> types;
+	const char* names[] = { "int" , "const std::string*" , "std::string* const" , "const std::string&" , "void (*)(std::string, int[3])" , "int (A::*)(int) const" , "volatile unsigned long" };
+	for( int i = 0 ; i < 30 ; i++ ) // More than 64 rows
+		for( const char* name : names )
+			types.emplace_back( name );
+	
+	parser::type_table table;
+	for( const parser::type& t : types )
+		table.push_back( t );
+	CHECK( table.size() == types.size() );
+	
+	parser::type_bitmap const_pointers = table.is_pointer() & table.is_const();
+	parser::type_bitmap strings = table.has_datatype( "std::string" );
+	for( size_t i = 0 ; i < types.size() ; i++ ){
+		const parser::type& t = types[i];
+		CHECK( table.to_type( i ) == t && table.to_string( i ) == t.to_string() );
+		CHECK( table.is_pointer()[i] == t.is_pointer() && table.is_member_pointer()[i] == t.is_member_pointer() );
+		CHECK( table.is_lvalue_reference()[i] == t.is_lvalue_reference() && table.is_plain()[i] == t.is_plain() );
+		CHECK( table.is_const()[i] == t.is_const() && table.is_volatile()[i] == t.is_volatile() );
+		CHECK( const_pointers[i] == ( t.is_pointer() && t.is_const() ) && strings[i] == ( t.get_datatype() == "std::string" ) );
+	}
+	CHECK( const_pointers.count() == 30 && ( ~const_pointers ).count() == types.size() - 30 && strings.indices()[1] == 2 );
+}
+
+void test_patterns()
+{
+	parser::pattern_set set{ "std::vector<$T> const&" , "$R (*)($A...)" , "$T $C::*" , "$T const*" , "std::pair<$T, $T>" , "char[$N]" , "int" , "$" };
+	auto matches = [&set]( const char* name ){
+		std::vector<size_t> result;
+		for( const parser::pattern_match& m : set.match( parser::type( name ) ) )
+			result.push_back( m.pattern );
+		return result;
+	};
+	CHECK( matches( "int" ) == std::vector<size_t>( { 6 , 7 } ) );
+	CHECK( matches( "std::vector<int> const&" ) == std::vector<size_t>( { 0 , 7 } ) );
+	CHECK( matches( "std::vector<int>&" ) == std::vector<size_t>( { 7 } ) );
+	CHECK( matches( "std::pair<int, long>" ) == std::vector<size_t>( { 7 } ) );
+	
+	parser::pattern_match m = set.match( parser::type( "const std::vector<int*>&" ) ).front();
+	CHECK( m.pattern == 0 && *m.get_type( "T" ) == parser::type( "int*" ) && !m.get_type( "U" ) );
+	m = set.match( parser::type( "void (*)(int, char)" ) ).front();
+	CHECK( m.pattern == 1 && m.get_type( "R" )->is_void() && m["A"]->size() == 2 && *m["A"]->back().value == parser::type( "char" ) );
+	CHECK( set.match( parser::type( "void (*)()" ) ).front()["A"]->empty() );
+	m = set.match( parser::type( "int (A::*)(int) const" ) ).front();
+	CHECK( m.pattern == 2 && m.get_type( "C" )->get_datatype() == "A" && ( m.get_type( "T" )->end() - 1 )->layer_type == parser::layer_type::function );
+	std::vector<parser::pattern_match> ptr = set.match( parser::type( "const volatile int*" ) );
+	CHECK( ptr.size() == 2 && ptr[0].pattern == 3 && *ptr[0].get_type( "T" ) == parser::type( "volatile int" ) );
+	CHECK( set.match( parser::type( "std::pair<int, int>" ) ).front().get_type( "T" )->get_datatype() == "int" );
+	CHECK( set.match( parser::type( "char[16]" ) ).front()["N"]->front().expression == "16" );
+	
+	bool thrown = false;
+	try{ set.add( "ns::A<$T>::B" ); }catch( const std::invalid_argument& ){ thrown = true; }
+	CHECK( thrown && set.size() == 8 );
+}
+
+void test_universe()
+{
+	parser::type_universe universe;
+	parser::interned_type a = universe.intern( "void (*)(int, std::string const&)" );
+	parser::interned_type b = universe.intern( parser::type( "void(*)( int , const std::string& )" ) );
+	parser::interned_type c = universe.intern( "void (*)(int, int)" );
+	CHECK( a == b && a != c && *a == parser::type( "void (*)(int, std::string const&)" ) && a->hash() == parser::type( "void (*)(int, const std::string&)" ).hash() );
+	CHECK( universe.size() == 4 ); // Two signatures, 'int' and 'const std::string&'
+	
+	// Parameters are shared
+	const auto& params = ( c->begin() + 1 )->arguments;
+	CHECK( params.begin()[0].get() == params.begin()[1].get() && params.begin()[0].get() == ( a->begin() + 1 )->arguments.begin()[0].get() );
+	CHECK( universe.intern( "int" ).get() == params.begin()[0].get() );
+	
+	// Concurrent insertion
+	const char* names[] = { "int" , "long (*)(int, long)" , "void (std::string)" , "char const*" , "std::vector<int>&" };
+	std::vector<parser::interned_type> results[4];
+	std::vector<std::thread> threads;
+	for( auto& result : results )
+		threads.emplace_back( [&universe, &result, &names]{
+			for( int i = 0 ; i < 200 ; i++ )
+				for( const char* name : names )
+					result.push_back( universe.intern( name ) );
+		});
+	for( std::thread& thread : threads )
+		thread.join();
+	for( const auto& result : results )
+		CHECK( result == results[0] );
+	CHECK( universe.size() == 4 + 6 ); // 'long', two signatures, "char const*", "std::vector<int>&" and 'std::string'
+}
+
+void test_stats()
+{
+#if CPP_TYPENAME_PARSER_STATS
+	static parser::parse_stats last;
+	parser::set_parse_stats_callback( []( std::string_view , const parser::parse_stats& stats ){ last = stats; } );
+	parser::thread_parse_stats() = {};
+	
+	parser::type( "void (int, long)" );
+	CHECK( last.parses == 1 && last.bytes_consumed == 16 && last.layers == 4 );
+	CHECK( last.parameter_parses == 2 && last.array_func_retries == 1 );
+	parser::type( "int ]" );
+	CHECK( last.array_func_backtracks == 1 && last.bytes_consumed == 4 );
+	parser::type_view( "int A::B" );
+	CHECK( last.mem_ptr_backtracks == 1 );
+	CHECK( parser::thread_parse_stats().parses == 3 );
+	
+	parser::set_parse_stats_callback( nullptr );
+#else
+	parser::type( "void (int, long)" );
+	CHECK( parser::thread_parse_stats().parses == 0 );
+#endif
+}
+
+int main()
+{
+	test_round_trip();
+	test_from_type();
+	test_parse();
+	test_type_view();
+	test_type_arena();
+	test_deep_nesting();
+	test_template_arguments();
+	test_canonical();
+	test_symbol_table();
+	test_hash();
+	test_inline_layers();
+	test_mangled();
+	test_static();
+	test_batch_and_cache();
+	test_stream();
+	test_database();
+	test_scanners();
+	test_find_types();
+	test_persistent();
+	test_lazy();
+	test_type_table();
+	test_patterns();
+	test_universe();
+	test_stats();
+
+	if( num_failures )
+		std::printf( "%d checks failed\n" , num_failures );
+	else
+		std::printf( "All checks passed\n" );
+	return num_failures ? 1 : 0;
+}